@@ -33,4 +33,7 @@
 #define BACK_WHEEL_OFFSET 5.0f
 
 // Sensor ports
-#define IMU_PORT 14
\ No newline at end of file
+#define IMU_PORT 14
+
+// Period of the tracking loop in ms (minimum of 2)
+#define TRACKING_PERIOD 10
\ No newline at end of file
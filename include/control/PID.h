@@ -7,8 +7,19 @@
 #ifndef _PID_H_
 #define _PID_H_
 
+#include <math.h>
+#include <stdint.h>
+
+/**
+ * Default time in seconds that a controller must stay within its settle bands to be settled
+*/
+#define DEFAULT_SETTLE_DWELL 0.25
+
 /**
  * \brief Class object to store PID constants
+ * 
+ * Gains are per second, so the integral gain multiplies error * seconds and the derivative
+ * gain multiplies error / second. This keeps their meaning the same at any loop rate.
 */
 class PIDInfo {
     public:
@@ -41,6 +52,53 @@ class PIDInfo {
         PIDInfo() {};
 };
 
+/**
+ * \brief Class object to store the conditions for a PID controller to be done
+*/
+class SettleCriteria {
+    public:
+        /**
+         * The largest absolute error that counts as settled
+        */
+        double errorBand;
+
+        /**
+         * The largest absolute rate of change of error (units per second) that counts as settled
+        */
+        double velocityBand;
+
+        /**
+         * Time in seconds that the error and velocity must stay within their bands to be settled
+        */
+        double dwellTime;
+
+        /**
+         * Time in seconds after the first step at which the controller gives up, 0 for no timeout
+        */
+        double timeout;
+
+        /**
+         * The largest absolute error that is close enough to start the next motion without
+         * waiting to settle, 0 to never exit early
+        */
+        double chainBand;
+
+        /**
+         * Initializes the SettleCriteria class
+         * @param errorBand The largest absolute error that counts as settled
+         * @param velocityBand The largest absolute rate of change of error that counts as settled
+         * @param dwellTime Time in seconds that the error and velocity must stay within their bands
+         * @param timeout Time in seconds after which the controller gives up, 0 for no timeout
+         * @param chainBand The largest absolute error that is close enough to chain the next motion, 0 to disable
+        */
+        SettleCriteria(double errorBand, double velocityBand = INFINITY, double dwellTime = DEFAULT_SETTLE_DWELL, double timeout = 0, double chainBand = 0);
+
+        /**
+         * Initializes the SettleCriteria class
+        */
+        SettleCriteria() {};
+};
+
 /**
  * \brief Class object to control a motor using PID
 */
@@ -55,10 +113,12 @@ class PIDController {
         double integral; // Integral (sum of errors) during PID loop
         double derivative; // Derivative during PID loop
 
-        double settleStart; // Time at which settling has started
-        bool settling, settled = false; // Settle flags
+        uint64_t lastTime = 0; // Time of the last step in microseconds, 0 before the first step
+        double settleTime = 0; // Time spent settling in seconds
+        double elapsedTime = 0; // Time since the first step in seconds
+        bool settling = false, settled = false; // Settle flags
 
-        double tolerance; // Tolerance value until settlable
+        SettleCriteria criteria; // Conditions for the controller to be settled
         double integralTolerance; // Integral tolerance for integral threshold (?)
 
         PIDInfo constants; // PID gain constants
@@ -73,18 +133,36 @@ class PIDController {
          * Initializes the PID Controller with preloaded values
          * @param target Current target
          * @param constants PID gain constants in PIDInfo form
-         * @param tolerance Tolerance value for error until controller settles
+         * @param tolerance Tolerance value for error until controller settles, other settle criteria use their defaults
          * @param integralTolerance Integral tolerance value for integral threshold
         */
         PIDController(double target, PIDInfo constants, double tolerance, double integralTolerance);
 
         /**
-         * Run a step of PID calculations given new sensor data
+         * Initializes the PID Controller with preloaded values
+         * @param target Current target
+         * @param constants PID gain constants in PIDInfo form
+         * @param criteria Conditions for the controller to be settled
+         * @param integralTolerance Integral tolerance value for integral threshold
+        */
+        PIDController(double target, PIDInfo constants, SettleCriteria criteria, double integralTolerance);
+
+        /**
+         * Run a step of PID calculations given new sensor data, using the time since the
+         * last step from the microsecond clock as the time delta
          * @param newSense New sensor data
          * @return New speed after running calculations 
         */
         double step(double newSense);
 
+        /**
+         * Run a step of PID calculations given new sensor data and the time since the last step
+         * @param newSense New sensor data
+         * @param dt Time since the last step in seconds, the first step after a reset should use 0
+         * @return New speed after running calculations 
+        */
+        double step(double newSense, double dt);
+
         /**
          * Reset all PID controller values back to their defaults
         */
@@ -98,9 +176,49 @@ class PIDController {
 
         /**
          * Check whether controller is settled or not
-         * @return Controller's settled state as boolean
+         * @return True once error and its rate of change have stayed within their bands for the dwell time
         */
         bool isSettled(); 
+
+        /**
+         * Check whether the controller has run for longer than its timeout
+         * @return True if the timeout has passed, always false if there is no timeout
+        */
+        bool isTimedOut();
+
+        /**
+         * Check whether the error is small enough to start the next motion without settling
+         * @return True if the error is within the chain band
+        */
+        bool isCloseEnough();
+
+        /**
+         * Check whether the controller is either settled or timed out, used to end a motion
+         * @return True if settled or timed out
+        */
+        bool isDone() { return this->isSettled() || this->isTimedOut(); };
+
+        /**
+         * Set the conditions for the controller to be settled
+         * @param criteria The new conditions
+        */
+        void setSettleCriteria(SettleCriteria criteria) { this->criteria = criteria; };
+
+        /**
+         * Returns the conditions for the controller to be settled
+        */
+        SettleCriteria getSettleCriteria() { return this->criteria; };
+
+        /**
+         * Set the PID gain constants
+         * @param constants The new gains
+        */
+        void setConstants(PIDInfo constants) { this->constants = constants; };
+
+        /**
+         * Returns the PID gain constants
+        */
+        PIDInfo getConstants() { return this->constants; };
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+/**
+ * \file feedforward.h
+ * 
+ * \brief Contains the Feedforward class, which predicts the output needed to reach a velocity and acceleration.
+*/
+
+#pragma once
+
+#include <math.h>
+
+/**
+ * \brief Class object to store feedforward constants and calculate feedforward output
+*/
+class Feedforward {
+    public:
+        /**
+         * The output needed to overcome static friction
+        */
+        double kS;
+
+        /**
+         * The output per unit of velocity
+        */
+        double kV;
+
+        /**
+         * The output per unit of acceleration
+        */
+        double kA;
+
+        /**
+         * Initializes the Feedforward class with preloaded constants
+         * @param kS Static friction gain
+         * @param kV Velocity gain
+         * @param kA Acceleration gain
+        */
+        Feedforward(double kS, double kV, double kA) : kS(kS), kV(kV), kA(kA) {};
+
+        /**
+         * Initializes the Feedforward class
+        */
+        Feedforward() : kS(0), kV(0), kA(0) {};
+
+        /**
+         * Calculate the output needed to move at a velocity and acceleration
+         * @param velocity The desired velocity
+         * @param acceleration The desired acceleration
+         * @return The predicted output
+        */
+        double calculate(double velocity, double acceleration) const {
+            // Static friction only acts while moving (or about to), in the direction of motion
+            double direction = velocity > 0 ? 1 : (velocity < 0 ? -1 : 0);
+            return (this->kS * direction) + (this->kV * velocity) + (this->kA * acceleration);
+        };
+};
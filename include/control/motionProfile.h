@@ -0,0 +1,145 @@
+/**
+ * \file motionProfile.h
+ * 
+ * \brief Contains the MotionProfile class, a trapezoidal or S-curve motion profile precomputed into a table.
+*/
+
+#pragma once
+
+/**
+ * Number of samples in a profile's table
+*/
+#define PROFILE_TABLE_SIZE 512
+
+/**
+ * Shortest time in seconds between samples in a profile's table, the period of the control loops.
+ * Profiles longer than PROFILE_TABLE_SIZE samples at this period are sampled less often.
+*/
+#define PROFILE_SAMPLE_PERIOD 0.01
+
+/**
+ * \brief The desired state at a point in time along a motion profile
+*/
+struct ProfileState {
+    double position = 0; // Distance from the start of the motion
+    double velocity = 0; // Rate of change of position per second
+    double acceleration = 0; // Rate of change of velocity per second
+};
+
+/**
+ * \brief The limits a motion profile stays within
+*/
+struct ProfileConstraints {
+    ProfileConstraints(double maxVelocity = 0, double maxAcceleration = 0, double maxJerk = 0)
+        : maxVelocity(maxVelocity), maxAcceleration(maxAcceleration), maxJerk(maxJerk) {};
+
+    /**
+     * The largest velocity in units per second
+    */
+    double maxVelocity;
+
+    /**
+     * The largest acceleration in units per second squared
+    */
+    double maxAcceleration;
+
+    /**
+     * The largest jerk (rate of change of acceleration) in units per second cubed, 0 for a
+     * trapezoidal profile where acceleration changes instantly
+    */
+    double maxJerk;
+};
+
+/**
+ * \brief Motion profile that moves a distance starting and ending at rest, within velocity,
+ * acceleration and optionally jerk limits
+ * 
+ * Without a jerk limit the velocity is trapezoidal: accelerate at the maximum rate, cruise and
+ * decelerate. With one it is an S-curve, where acceleration ramps up and down as well, which
+ * is gentler on the drivetrain and less likely to make wheels slip. Short motions that can't
+ * reach the limits peak early instead.
+ * 
+ * The profile is worked out when built and stored in a fixed-size table, so sampling it in a
+ * control loop is a table read. Profiles for a whole route can be built ahead of time, ex. in
+ * initialize(). The same profiles work for turns in radians.
+*/
+class MotionProfile {
+    public:
+        /**
+         * Initializes the MotionProfile class with a motion of length 0
+        */
+        MotionProfile() { this->build(0, ProfileConstraints(1, 1)); };
+
+        /**
+         * Initializes the MotionProfile class and builds the profile
+         * @param distance The distance to move, which can be negative
+         * @param constraints The limits to stay within, velocity and acceleration must be positive
+        */
+        MotionProfile(double distance, ProfileConstraints constraints) { this->build(distance, constraints); };
+
+        /**
+         * Work out the profile and fill its table
+         * @param distance The distance to move, which can be negative
+         * @param constraints The limits to stay within, velocity and acceleration must be positive
+        */
+        void build(double distance, ProfileConstraints constraints);
+
+        /**
+         * Get the desired state at a point in time from the table
+         * @param t Time since the start of the motion in seconds
+         * @return The desired state, at rest on the target after the motion ends
+        */
+        ProfileState sample(double t) const;
+
+        /**
+         * Work out the desired state at a point in time without the table
+         * @param t Time since the start of the motion in seconds
+         * @return The desired state, at rest on the target after the motion ends
+        */
+        ProfileState evaluate(double t) const;
+
+        /**
+         * Returns the time the motion takes in seconds
+        */
+        double getDuration() const { return this->duration; };
+
+        /**
+         * Returns the distance the motion covers
+        */
+        double getDistance() const { return this->distance; };
+
+        /**
+         * Returns the time in seconds between samples in the table
+        */
+        double getSamplePeriod() const { return this->samplePeriod; };
+
+    private:
+        /**
+         * \brief A table entry, stored as floats to keep the table small
+        */
+        struct Sample {
+            float position, velocity, acceleration;
+        };
+
+        double distance; // Signed distance to move
+        double direction; // 1 or -1
+
+        double jerk; // Magnitude of jerk, infinite for trapezoidal profiles
+        double peakAcceleration; // Largest acceleration reached
+        double peakVelocity; // Largest velocity reached, lower than the maximum for short motions
+        double jerkTime; // Time spent ramping acceleration at each end of the acceleration phase
+        double accelTime; // Time spent accelerating (and decelerating)
+        double cruiseTime; // Time spent at the peak velocity
+        double duration; // Total time
+
+        Sample table[PROFILE_TABLE_SIZE];
+        int samples; // Number of samples used
+        double samplePeriod; // Time between samples
+        double sampleRate; // Samples per second, to multiply instead of divide when sampling
+
+        /**
+         * Work out the state during the acceleration phase, which the deceleration phase mirrors
+         * @param t Time since the start of the motion in seconds, in range [0, accelTime]
+        */
+        ProfileState accelerating(double t) const;
+};
@@ -0,0 +1,298 @@
+/**
+ * \file mpcTracker.h
+ *
+ * \brief Contains the MPCTracker class template, a model predictive trajectory tracker for skid
+ * steer drivetrains.
+ *
+ * Doesn't depend on PROS so it can be benchmarked off the robot (see tools/mpcBench.cpp).
+*/
+
+#pragma once
+
+#include <math.h>
+#include "control/trajectoryTracker.h"
+
+/**
+ * Default number of steps the tracker plans ahead
+*/
+#define MPC_DEFAULT_HORIZON 15
+
+/**
+ * \brief Costs and timing for MPCTracker
+*/
+struct MPCSettings {
+    /**
+     * Time between planned steps in seconds, the horizon covers this times the number of steps
+    */
+    double stepTime = 0.05;
+
+    /**
+     * Cost per square inch of distance from the trajectory at each step
+    */
+    double positionWeight = 1;
+
+    /**
+     * Cost per square radian of heading error at each step
+    */
+    double headingWeight = 20;
+
+    /**
+     * Cost per square inch per second of each wheel's velocity differing from the trajectory's,
+     * higher makes smaller corrections
+    */
+    double inputWeight = 0.002;
+
+    /**
+     * Number of times the plan is relinearized and improved per step
+    */
+    int iterations = 2;
+};
+
+/**
+ * \brief Tracks a trajectory by planning the wheel velocities for the next N steps that keep the
+ * robot closest to it, and driving the first of them
+ *
+ * Each step runs a few iterations of iLQR: the robot's motion under the current plan is predicted
+ * with a skid steer model, the model is linearized along that prediction, a Riccati recursion
+ * finds the best change to the plan, and the new plan is rolled out with each wheel's velocity
+ * clamped to what the drive can reach. The plan is kept and moved along by the time that has
+ * passed to warm start the next step. Everything is stored in fixed size arrays, so no memory is
+ * allocated while tracking.
+ *
+ * States are (x, y, heading) with headings clockwise from +y like TrackingData, so the robot
+ * drives along (sin(heading), cos(heading)) and turns clockwise when the left wheels are faster.
+ * Inputs are (left, right) wheel velocities.
+*/
+template <int N>
+class MPCTracker : public TrajectoryTracker {
+    public:
+        /**
+         * Initializes the MPCTracker class
+         * @param trackWidth Distance between the left and right wheels in inches (WHEELBASE in chassis.h)
+         * @param maxVelocity Top velocity of the wheels in inches per second
+         * @param settings Costs and timing
+        */
+        MPCTracker(double trackWidth, double maxVelocity, MPCSettings settings = MPCSettings())
+            : trackWidth(trackWidth), maxVelocity(maxVelocity), settings(settings) {};
+
+        /**
+         * Forget the last plan, called before following a new trajectory
+        */
+        void reset() override { this->warm = false; };
+
+        /**
+         * Work out the wheel velocities for the next step
+         * @param trajectory The trajectory being followed
+         * @param t Time since the trajectory started in seconds
+         * @param position The robot's position in inches
+         * @param heading The robot's heading in radians, clockwise from +y like TrackingData
+         * @return The velocities to drive each side at
+        */
+        WheelVelocities step(const Trajectory& trajectory, double t, Vector2 position, double heading) override {
+            double dt = this->settings.stepTime;
+
+            // Reference states and inputs over the horizon, with headings unwrapped to follow each other
+            for (int k = 0; k <= N; k++) {
+                TrajectoryState state = trajectory.sample(t + k * dt);
+                this->reference[k][0] = state.position.getX();
+                this->reference[k][1] = state.position.getY();
+                this->reference[k][2] = k == 0 ? state.heading
+                    : this->reference[k - 1][2] + remainder(state.heading - this->reference[k - 1][2], 2 * M_PI);
+                if (k < N) {
+                    this->referenceInput[k][0] = state.velocity + state.angularVelocity * this->trackWidth / 2;
+                    this->referenceInput[k][1] = state.velocity - state.angularVelocity * this->trackWidth / 2;
+                }
+            }
+
+            // Start from the last plan, moved along by the time since it was made, or from the trajectory
+            double shift = (t - this->lastTime) / dt;
+            bool reuse = this->warm && shift >= 0 && shift < N - 1;
+            for (int k = 0; k < N; k++) {
+                // Reads from later in the plan than it writes, so it can shift in place
+                double index = k + shift;
+                int i0 = (int) index;
+                if (reuse && i0 + 1 < N) {
+                    double f = index - i0;
+                    this->input[k][0] = this->input[i0][0] + (this->input[i0 + 1][0] - this->input[i0][0]) * f;
+                    this->input[k][1] = this->input[i0][1] + (this->input[i0 + 1][1] - this->input[i0][1]) * f;
+                } else {
+                    this->input[k][0] = this->referenceInput[k][0];
+                    this->input[k][1] = this->referenceInput[k][1];
+                }
+            }
+
+            // Unwrap the robot's heading next to the trajectory's
+            this->state[0][0] = position.getX();
+            this->state[0][1] = position.getY();
+            this->state[0][2] = this->reference[0][2] + remainder(heading - this->reference[0][2], 2 * M_PI);
+            this->rollout();
+
+            for (int i = 0; i < this->settings.iterations; i++) {
+                this->backwardPass();
+                this->forwardPass();
+            }
+
+            this->lastTime = t;
+            this->warm = true;
+
+            WheelVelocities wheels;
+            wheels.left = this->input[0][0];
+            wheels.right = this->input[0][1];
+            return wheels;
+        };
+
+    private:
+        double trackWidth, maxVelocity;
+        MPCSettings settings;
+
+        double reference[N + 1][3]; // Trajectory states over the horizon
+        double referenceInput[N][2]; // Trajectory wheel velocities over the horizon
+        double state[N + 1][3]; // Predicted states under the plan
+        double input[N][2]; // Planned wheel velocities
+
+        double gain[N][2][3]; // Feedback from state error to input change
+        double offset[N][2]; // Open loop input change
+
+        bool warm = false; // Whether the plan holds a previous solution
+        double lastTime = 0; // Trajectory time the plan starts at
+
+        /**
+         * Advance the skid steer model by one step
+        */
+        void model(const double s[3], const double u[2], double next[3]) const {
+            double v = (u[0] + u[1]) / 2;
+            double w = (u[0] - u[1]) / this->trackWidth;
+            double dt = this->settings.stepTime;
+
+            // Forward is Rotation2::fromHeading(heading).rotate(Vector2(0, 1)), the same as TrackingData::getForward()
+            next[0] = s[0] + v * sin(s[2]) * dt;
+            next[1] = s[1] + v * cos(s[2]) * dt;
+            next[2] = s[2] + w * dt;
+        };
+
+        /**
+         * Clamp a wheel velocity to what the drive can reach
+        */
+        double clamp(double velocity) const { return fmin(fmax(velocity, -this->maxVelocity), this->maxVelocity); };
+
+        /**
+         * Predict the states under the current plan
+        */
+        void rollout() {
+            for (int k = 0; k < N; k++) {
+                this->input[k][0] = this->clamp(this->input[k][0]);
+                this->input[k][1] = this->clamp(this->input[k][1]);
+                this->model(this->state[k], this->input[k], this->state[k + 1]);
+            }
+        };
+
+        /**
+         * Find the feedback and open loop changes to the plan with a Riccati recursion on the
+         * model linearized along the predicted states
+        */
+        void backwardPass() {
+            double q[3] = {this->settings.positionWeight, this->settings.positionWeight, this->settings.headingWeight};
+            double r = this->settings.inputWeight;
+            double dt = this->settings.stepTime;
+
+            // Value function gradient and hessian, starting from the cost of the last state
+            double vx[3], vxx[3][3] = {};
+            for (int i = 0; i < 3; i++) {
+                vx[i] = q[i] * (this->state[N][i] - this->reference[N][i]);
+                vxx[i][i] = q[i];
+            }
+
+            for (int k = N - 1; k >= 0; k--) {
+                // Linearized model, A = I + dt * df/ds and B = dt * df/du, where the forward vector
+                // (sin, cos) changes with heading by (cos, -sin)
+                double v = (this->input[k][0] + this->input[k][1]) / 2;
+                double s = sin(this->state[k][2]), c = cos(this->state[k][2]);
+                double a[3][3] = {{1, 0, v * c * dt}, {0, 1, -v * s * dt}, {0, 0, 1}};
+                double b[3][2] = {{s * dt / 2, s * dt / 2}, {c * dt / 2, c * dt / 2},
+                    {dt / this->trackWidth, -dt / this->trackWidth}};
+
+                // Gradients and hessians of the cost to go with respect to the state and input at this step
+                double qx[3], qu[2], qxx[3][3], quu[2][2], qux[2][3];
+                double vxxA[3][3], vxxB[3][2];
+                for (int i = 0; i < 3; i++) {
+                    for (int j = 0; j < 3; j++) {
+                        vxxA[i][j] = vxx[i][0] * a[0][j] + vxx[i][1] * a[1][j] + vxx[i][2] * a[2][j];
+                    }
+                    for (int j = 0; j < 2; j++) {
+                        vxxB[i][j] = vxx[i][0] * b[0][j] + vxx[i][1] * b[1][j] + vxx[i][2] * b[2][j];
+                    }
+                }
+                for (int i = 0; i < 3; i++) {
+                    qx[i] = q[i] * (this->state[k][i] - this->reference[k][i]) + a[0][i] * vx[0] + a[1][i] * vx[1] + a[2][i] * vx[2];
+                    for (int j = 0; j < 3; j++) {
+                        qxx[i][j] = (i == j ? q[i] : 0) + a[0][i] * vxxA[0][j] + a[1][i] * vxxA[1][j] + a[2][i] * vxxA[2][j];
+                    }
+                }
+                for (int i = 0; i < 2; i++) {
+                    qu[i] = r * (this->input[k][i] - this->referenceInput[k][i]) + b[0][i] * vx[0] + b[1][i] * vx[1] + b[2][i] * vx[2];
+                    for (int j = 0; j < 2; j++) {
+                        quu[i][j] = (i == j ? r : 0) + b[0][i] * vxxB[0][j] + b[1][i] * vxxB[1][j] + b[2][i] * vxxB[2][j];
+                    }
+                    for (int j = 0; j < 3; j++) {
+                        qux[i][j] = b[0][i] * vxxA[0][j] + b[1][i] * vxxA[1][j] + b[2][i] * vxxA[2][j];
+                    }
+                }
+
+                // Invert the 2x2 input hessian, which the input cost keeps positive definite
+                double det = quu[0][0] * quu[1][1] - quu[0][1] * quu[1][0];
+                double inv[2][2] = {{quu[1][1] / det, -quu[0][1] / det}, {-quu[1][0] / det, quu[0][0] / det}};
+
+                double (&K)[2][3] = this->gain[k];
+                double (&d)[2] = this->offset[k];
+                for (int i = 0; i < 2; i++) {
+                    d[i] = -(inv[i][0] * qu[0] + inv[i][1] * qu[1]);
+                    for (int j = 0; j < 3; j++) {
+                        K[i][j] = -(inv[i][0] * qux[0][j] + inv[i][1] * qux[1][j]);
+                    }
+                }
+
+                // Value function at this step, Vx = Qx + K'Quu d + K'Qu + Qux'd and
+                // Vxx = Qxx + K'Quu K + K'Qux + Qux'K
+                for (int i = 0; i < 3; i++) {
+                    double quuD[2] = {quu[0][0] * d[0] + quu[0][1] * d[1], quu[1][0] * d[0] + quu[1][1] * d[1]};
+                    vx[i] = qx[i] + K[0][i] * (quuD[0] + qu[0]) + K[1][i] * (quuD[1] + qu[1]) + qux[0][i] * d[0] + qux[1][i] * d[1];
+                }
+                for (int i = 0; i < 3; i++) {
+                    for (int j = i; j < 3; j++) {
+                        double quuK0 = quu[0][0] * K[0][j] + quu[0][1] * K[1][j];
+                        double quuK1 = quu[1][0] * K[0][j] + quu[1][1] * K[1][j];
+                        double value = qxx[i][j] + K[0][i] * quuK0 + K[1][i] * quuK1
+                            + K[0][i] * qux[0][j] + K[1][i] * qux[1][j] + qux[0][i] * K[0][j] + qux[1][i] * K[1][j];
+                        vxx[i][j] = value;
+                        vxx[j][i] = value;
+                    }
+                }
+            }
+        };
+
+        /**
+         * Apply the changes to the plan through the nonlinear model, clamping each input
+        */
+        void forwardPass() {
+            double s[3] = {this->state[0][0], this->state[0][1], this->state[0][2]};
+            for (int k = 0; k < N; k++) {
+                double error[3] = {s[0] - this->state[k][0], s[1] - this->state[k][1], s[2] - this->state[k][2]};
+                for (int i = 0; i < 2; i++) {
+                    double change = this->offset[k][i] + this->gain[k][i][0] * error[0] + this->gain[k][i][1] * error[1]
+                        + this->gain[k][i][2] * error[2];
+                    this->input[k][i] = this->clamp(this->input[k][i] + change);
+                }
+                for (int i = 0; i < 3; i++) {
+                    this->state[k][i] = s[i];
+                }
+                double next[3];
+                this->model(s, this->input[k], next);
+                for (int i = 0; i < 3; i++) {
+                    s[i] = next[i];
+                }
+            }
+            for (int i = 0; i < 3; i++) {
+                this->state[N][i] = s[i];
+            }
+        };
+};
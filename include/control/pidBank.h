@@ -0,0 +1,254 @@
+/**
+ * \file pidBank.h
+ * 
+ * \brief Contains the PIDBank class template, which steps many PID controllers at once.
+*/
+
+#pragma once
+
+#include "control/PID.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PID_BANK_NEON
+#endif
+
+/**
+ * \brief Stores the gains and state of up to N PID controllers as structure-of-arrays and
+ * steps all of them in one pass, 4 at a time with NEON on the V5.
+ * 
+ * Each mechanism gets a Handle from add() to set its target and sensor value and read its
+ * output, while a single task calls step() once per tick for all of them. Uses floats since
+ * the V5's NEON unit only works on single precision.
+*/
+template <int N>
+class PIDBank {
+    public:
+        /**
+         * \brief A view of one controller in the bank
+        */
+        class Handle {
+            public:
+                /**
+                 * Initializes the Handle class, use PIDBank::add() instead
+                 * @param bank The bank the controller is in
+                 * @param index The index of the controller in the bank
+                */
+                Handle(PIDBank* bank = nullptr, int index = -1) : bank(bank), index(index) {};
+
+                /**
+                 * Returns whether the handle refers to a controller
+                */
+                bool valid() const { return this->bank != nullptr; };
+
+                /**
+                 * Set the target value of the controller
+                 * @param target The new target
+                */
+                void setTarget(float target) { this->bank->target[this->index] = target; };
+
+                /**
+                 * Set the sensor value used in the next step
+                 * @param sense The new sensor value
+                */
+                void setSense(float sense) { this->bank->sense[this->index] = sense; };
+
+                /**
+                 * Set the PID gain constants (per second)
+                 * @param constants The new gains
+                */
+                void setConstants(PIDInfo constants) { this->bank->setConstants(this->index, constants); };
+
+                /**
+                 * Set the output range and integral limit
+                 * @param outputLimit The output is limited to [-outputLimit, outputLimit]
+                 * @param integralLimit The integral is limited to [-integralLimit, integralLimit]
+                */
+                void setLimits(float outputLimit, float integralLimit) {
+                    this->bank->outputLimit[this->index] = outputLimit;
+                    this->bank->integralLimit[this->index] = integralLimit;
+                };
+
+                /**
+                 * Returns the output from the last step
+                */
+                float getOutput() const { return this->bank->output[this->index]; };
+
+                /**
+                 * Returns the error from the last step
+                */
+                float getError() const { return this->bank->lastError[this->index]; };
+
+                /**
+                 * Reset the integral and derivative state of the controller
+                */
+                void reset() { this->bank->reset(this->index); };
+
+            private:
+                PIDBank* bank;
+                int index;
+        };
+
+        /**
+         * Initializes the PIDBank class with no controllers
+        */
+        PIDBank() {
+            for (int i = 0; i < PADDED; i++) {
+                this->kP[i] = this->kI[i] = this->kD[i] = 0;
+                this->target[i] = this->sense[i] = this->output[i] = 0;
+                this->integral[i] = this->lastError[i] = this->hasLastError[i] = 0;
+                this->outputLimit[i] = 127;
+                this->integralLimit[i] = 1e30f;
+            }
+        };
+
+        /**
+         * Add a controller to the bank
+         * @param constants PID gain constants (per second)
+         * @return A handle to the new controller, which is invalid if the bank is full
+        */
+        Handle add(PIDInfo constants) {
+            if (this->count >= N) {
+                return Handle();
+            }
+
+            this->setConstants(this->count, constants);
+            this->reset(this->count);
+            return Handle(this, this->count++);
+        };
+
+        /**
+         * Returns the number of controllers in the bank
+        */
+        int size() const { return this->count; };
+
+        /**
+         * Run a step of every controller using the sensor values set through their handles
+         * @param dt Time since the last step in seconds
+        */
+        void step(float dt) {
+            if (dt <= 0) {
+                return;
+            }
+            int i = 0;
+
+#ifdef PID_BANK_NEON
+            const float32x4_t dtV = vdupq_n_f32(dt);
+            const float32x4_t invDtV = vdupq_n_f32(1.0f / dt);
+            const float32x4_t one = vdupq_n_f32(1);
+
+            // Step 4 controllers at a time
+            for (; i + 4 <= this->count; i += 4) {
+                float32x4_t error = vsubq_f32(vld1q_f32(this->target + i), vld1q_f32(this->sense + i));
+
+                // Integral of error over time, clamped to the integral limit
+                float32x4_t iLimit = vld1q_f32(this->integralLimit + i);
+                float32x4_t integral = vmlaq_f32(vld1q_f32(this->integral + i), error, dtV);
+                integral = vminq_f32(vmaxq_f32(integral, vnegq_f32(iLimit)), iLimit);
+
+                // Rate of change of error, masked to 0 on the first step
+                float32x4_t derivative = vmulq_f32(vsubq_f32(error, vld1q_f32(this->lastError + i)), invDtV);
+                derivative = vmulq_f32(derivative, vld1q_f32(this->hasLastError + i));
+
+                // Run PID calculation with gains, clamped to the output limit
+                float32x4_t out = vmulq_f32(vld1q_f32(this->kP + i), error);
+                out = vmlaq_f32(out, vld1q_f32(this->kI + i), integral);
+                out = vmlaq_f32(out, vld1q_f32(this->kD + i), derivative);
+                float32x4_t oLimit = vld1q_f32(this->outputLimit + i);
+                out = vminq_f32(vmaxq_f32(out, vnegq_f32(oLimit)), oLimit);
+
+                vst1q_f32(this->integral + i, integral);
+                vst1q_f32(this->lastError + i, error);
+                vst1q_f32(this->hasLastError + i, one);
+                vst1q_f32(this->output + i, out);
+            }
+#endif
+
+            // Step the rest (or all of them without NEON) one at a time
+            this->stepFrom(i, dt);
+        };
+
+        /**
+         * Run a step of every controller one at a time without NEON, the same as step() on a
+         * computer. Used to check the NEON path
+         * @param dt Time since the last step in seconds
+        */
+        void stepScalar(float dt) {
+            if (dt > 0) {
+                this->stepFrom(0, dt);
+            }
+        };
+
+    private:
+        /**
+         * N rounded up to a multiple of 4 so the arrays are whole NEON vectors
+        */
+        static const int PADDED = (N + 3) / 4 * 4;
+
+        /**
+         * Step the controllers from an index to the end one at a time, written so the compiler can vectorize it
+         * @param start Index of the first controller to step
+         * @param dt Time since the last step in seconds, above 0
+        */
+        void stepFrom(int start, float dt) {
+            float invDt = 1.0f / dt;
+            for (int i = start; i < this->count; i++) {
+                float error = this->target[i] - this->sense[i];
+
+                float integral = this->integral[i] + error * dt;
+                float iLimit = this->integralLimit[i];
+                integral = integral > iLimit ? iLimit : (integral < -iLimit ? -iLimit : integral);
+
+                float derivative = (error - this->lastError[i]) * invDt * this->hasLastError[i];
+
+                float out = (this->kP[i] * error) + (this->kI[i] * integral) + (this->kD[i] * derivative);
+                float oLimit = this->outputLimit[i];
+                out = out > oLimit ? oLimit : (out < -oLimit ? -oLimit : out);
+
+                this->integral[i] = integral;
+                this->lastError[i] = error;
+                this->hasLastError[i] = 1;
+                this->output[i] = out;
+            }
+        };
+
+        /**
+         * Set the gains of a controller
+        */
+        void setConstants(int index, PIDInfo constants) {
+            this->kP[index] = constants.p;
+            this->kI[index] = constants.i;
+            this->kD[index] = constants.d;
+        };
+
+        /**
+         * Reset the state of a controller
+        */
+        void reset(int index) {
+            this->integral[index] = 0;
+            this->lastError[index] = 0;
+            this->hasLastError[index] = 0;
+            this->output[index] = 0;
+        };
+
+        // Gains
+        alignas(16) float kP[PADDED];
+        alignas(16) float kI[PADDED];
+        alignas(16) float kD[PADDED];
+
+        // Inputs and outputs
+        alignas(16) float target[PADDED];
+        alignas(16) float sense[PADDED];
+        alignas(16) float output[PADDED];
+
+        // Limits
+        alignas(16) float outputLimit[PADDED];
+        alignas(16) float integralLimit[PADDED];
+
+        // State
+        alignas(16) float integral[PADDED];
+        alignas(16) float lastError[PADDED];
+        alignas(16) float hasLastError[PADDED]; // 1 once a controller has a last error, 0 before its first step
+
+        int count = 0; // Number of controllers added
+};
@@ -0,0 +1,245 @@
+/**
+ * \file policyPID.h
+ * 
+ * \brief Contains the PID class template, a PID controller whose features are chosen at compile time.
+*/
+
+#pragma once
+
+#include <type_traits>
+#include "control/PID.h"
+
+/**
+ * \brief Optional features for the PID class template. Each one holds its own settings and state,
+ * so a controller only stores what it uses.
+*/
+namespace PIDPolicy {
+    /**
+     * \brief Limits the integral to [-limit, limit] to prevent windup
+    */
+    struct IntegralClamp {
+        IntegralClamp(double limit = 0) : limit(limit) {};
+
+        /**
+         * The largest absolute value the integral can reach
+        */
+        double limit;
+    };
+
+    /**
+     * \brief Uses the change in sensor value instead of the change in error for the derivative,
+     * so changing the target doesn't cause a spike in output
+    */
+    struct DerivativeOnMeasurement {
+        /**
+         * The sensor value from the last step
+        */
+        double lastSense = 0;
+    };
+
+    /**
+     * \brief Low pass filters the derivative to reduce sensor noise
+    */
+    struct DerivativeFilter {
+        DerivativeFilter(double alpha = 1) : alpha(alpha) {};
+
+        /**
+         * Weight of the newest derivative in the range [0, 1], lower filters more
+        */
+        double alpha;
+
+        /**
+         * The filtered derivative
+        */
+        double filteredDerivative = 0;
+    };
+
+    /**
+     * \brief Adds the target multiplied by a gain to the output
+    */
+    struct Feedforward {
+        Feedforward(double kF = 0) : kF(kF) {};
+
+        /**
+         * The feedforward gain
+        */
+        double kF;
+    };
+
+    /**
+     * \brief Limits the output to [min, max]
+    */
+    struct OutputLimit {
+        OutputLimit(double min = -127, double max = 127) : min(min), max(max) {};
+
+        /**
+         * The smallest output
+        */
+        double min;
+
+        /**
+         * The largest output
+        */
+        double max;
+    };
+
+    /**
+     * \brief Limits how quickly the output can change
+    */
+    struct Slew {
+        Slew(double maxChange = 127) : maxChange(maxChange) {};
+
+        /**
+         * The largest change in output per second (per step when stepping without a time delta)
+        */
+        double maxChange;
+
+        /**
+         * The output from the last step
+        */
+        double lastOutput = 0;
+    };
+}
+
+/**
+ * \brief PID controller with optional features chosen at compile time from PIDPolicy, ex.
+ * PID<PIDPolicy::IntegralClamp, PIDPolicy::OutputLimit>.
+ * 
+ * Features that aren't chosen are compiled out completely, so they cost no memory and no time.
+ * Everything is stored in the object itself, so it can be a member or local variable without
+ * using the heap.
+*/
+template <typename... Policies>
+class PID : public Policies... {
+    public:
+        /**
+         * The current target value for the controller
+        */
+        double target = 0;
+
+        /**
+         * Initializes the PID class with gains and settings for each feature
+         * @param constants PID gain constants in PIDInfo form
+         * @param policies Settings for each feature, in the same order as the template
+        */
+        PID(PIDInfo constants, Policies... policies) : Policies(policies)..., constants(constants) {};
+
+        /**
+         * Run a step of PID calculations given new sensor data, treating every step as one
+         * unit of time (gains are per step)
+         * @param sense New sensor data
+         * @return New output after running calculations 
+        */
+        double step(double sense) {
+            return this->step(sense, 1);
+        }
+
+        /**
+         * Run a step of PID calculations given new sensor data and the time since the last
+         * step, so the same gains behave the same at any loop rate (gains are per second)
+         * @param sense New sensor data
+         * @param dt Time since the last step in seconds
+         * @return New output after running calculations 
+        */
+        double step(double sense, double dt) {
+            double error = this->target - sense;
+
+            // Add integral to error since integral is sum of all errors over time
+            this->integral += error * dt;
+            if constexpr (has<PIDPolicy::IntegralClamp>()) {
+                double limit = this->PIDPolicy::IntegralClamp::limit;
+                this->integral = this->integral > limit ? limit : (this->integral < -limit ? -limit : this->integral);
+            }
+
+            // Get derivative as a rate of change (0 on first step since there's nothing to compare to)
+            double derivative = 0;
+            bool hasDerivative = !this->firstStep && dt > 0;
+            if constexpr (has<PIDPolicy::DerivativeOnMeasurement>()) {
+                if (hasDerivative) {
+                    derivative = -(sense - this->lastSense) / dt;
+                }
+                this->lastSense = sense;
+            } else {
+                if (hasDerivative) {
+                    derivative = (error - this->lastError) / dt;
+                }
+            }
+            if constexpr (has<PIDPolicy::DerivativeFilter>()) {
+                this->filteredDerivative += this->alpha * (derivative - this->filteredDerivative);
+                derivative = this->filteredDerivative;
+            }
+            this->lastError = error;
+            this->firstStep = false;
+
+            // Run PID calculation with gains
+            double output = (this->constants.p * error) + (this->constants.i * this->integral) + (this->constants.d * derivative);
+
+            if constexpr (has<PIDPolicy::Feedforward>()) {
+                output += this->kF * this->target;
+            }
+            if constexpr (has<PIDPolicy::OutputLimit>()) {
+                output = output > this->max ? this->max : (output < this->min ? this->min : output);
+            }
+            if constexpr (has<PIDPolicy::Slew>()) {
+                double change = output - this->lastOutput;
+                double maxStepChange = this->maxChange * dt;
+                if (change > maxStepChange) {
+                    output = this->lastOutput + maxStepChange;
+                } else if (change < -maxStepChange) {
+                    output = this->lastOutput - maxStepChange;
+                }
+                this->lastOutput = output;
+            }
+
+            return output;
+        }
+
+        /**
+         * Reset the state of the controller, keeping the gains, target and settings
+        */
+        void reset() {
+            this->integral = 0;
+            this->lastError = 0;
+            this->firstStep = true;
+
+            if constexpr (has<PIDPolicy::DerivativeOnMeasurement>()) {
+                this->lastSense = 0;
+            }
+            if constexpr (has<PIDPolicy::DerivativeFilter>()) {
+                this->filteredDerivative = 0;
+            }
+            if constexpr (has<PIDPolicy::Slew>()) {
+                this->lastOutput = 0;
+            }
+        }
+
+        /**
+         * Get the error value
+         * @return The error from the last step, aka target - sensor value
+        */
+        double getError() const { return this->lastError; };
+
+        /**
+         * Set the PID gain constants
+         * @param constants The new gains
+        */
+        void setConstants(PIDInfo constants) { this->constants = constants; };
+
+        /**
+         * Returns the PID gain constants
+        */
+        PIDInfo getConstants() const { return this->constants; };
+
+    private:
+        /**
+         * Whether a feature was chosen for this controller
+        */
+        template <typename Policy>
+        static constexpr bool has() { return (std::is_same<Policy, Policies>::value || ...); };
+
+        PIDInfo constants; // PID gain constants
+
+        double integral = 0; // Integral (sum of errors) during PID loop
+        double lastError = 0; // Last error value
+        bool firstStep = true; // Whether the next step is the first one
+};
@@ -0,0 +1,75 @@
+/**
+ * \file profileFollower.h
+ * 
+ * \brief Contains the ProfileFollower class, which follows a motion profile with feedforward and PID correction.
+ * 
+ * Doesn't depend on PROS so it can be simulated off the robot (see tools/driveSim.cpp).
+*/
+
+#pragma once
+
+#include "control/PID.h"
+#include "control/policyPID.h"
+#include "control/feedforward.h"
+#include "control/motionProfile.h"
+
+/**
+ * \brief Follows a motion profile, using feedforward to produce the profile's velocity and
+ * acceleration and PID to correct the error from the profile's position
+*/
+class ProfileFollower {
+    public:
+        /**
+         * Initializes the ProfileFollower class
+         * @param feedforward Feedforward constants for the system being driven
+         * @param constants PID gain constants (per second) for correcting position error
+         * @param criteria Conditions for the motion to be settled once the profile has ended
+         * @param maxOutput The output is limited to [-maxOutput, maxOutput]
+        */
+        ProfileFollower(Feedforward feedforward, PIDInfo constants, SettleCriteria criteria, double maxOutput = 127);
+
+        /**
+         * Start following a new profile from the current position
+         * @param profile The profile to follow, which must stay valid while following
+         * @param startPosition The sensor value at the start of the profile
+        */
+        void start(const MotionProfile& profile, double startPosition);
+
+        /**
+         * Run a step of the follower given new sensor data
+         * @param sense New sensor data
+         * @param dt Time since the last step in seconds
+         * @return The output to drive the system with
+        */
+        double step(double sense, double dt);
+
+        /**
+         * Returns the error from the final target at the last step
+        */
+        double getError() const { return this->error; };
+
+        /**
+         * Returns the time since the start of the profile in seconds
+        */
+        double getTime() const { return this->time; };
+
+        /**
+         * Returns whether the profile has ended and the error has settled, or the motion has timed out
+        */
+        bool isDone() const;
+
+    private:
+        Feedforward feedforward;
+        PID<> controller; // Corrects the error from the profile's position
+        SettleCriteria criteria;
+        double maxOutput;
+
+        const MotionProfile* profile = nullptr;
+        double startPosition = 0;
+
+        double time = 0; // Time since the start of the profile in seconds
+        double error = 0; // Error from the final target
+        double lastError = 0; // Error from the final target at the step before
+        double settleTime = 0; // Time spent within the settle bands in seconds
+        bool settled = false;
+};
@@ -0,0 +1,129 @@
+/**
+ * \file purePursuit.h
+ * 
+ * \brief Contains the PurePursuit class, a path follower for nonholonomic drivetrains.
+ * 
+ * Doesn't depend on PROS so it can be benchmarked off the robot (see tools/pursuitBench.cpp).
+*/
+
+#pragma once
+
+#include <vector>
+#include "tracking/pose2.h"
+
+/**
+ * \brief Settings for following a path with pure pursuit
+*/
+struct PursuitSettings {
+    /**
+     * Lookahead distance in inches when stopped
+    */
+    double minLookahead = 8;
+
+    /**
+     * Largest lookahead distance in inches
+    */
+    double maxLookahead = 20;
+
+    /**
+     * Extra lookahead distance per inch per second of speed, so the robot looks further ahead
+     * and cuts corners less sharply when moving fast
+    */
+    double lookaheadGain = 0.3;
+
+    /**
+     * Largest drive output in range [0, 127]
+    */
+    double maxSpeed = 100;
+
+    /**
+     * Smallest drive output in range [0, 127] before the end of the path
+    */
+    double minSpeed = 20;
+
+    /**
+     * Distance in inches from the end of the path at which to start slowing down
+    */
+    double slowdownDistance = 12;
+
+    /**
+     * Distance in inches from the end of the path at which the path is done. The path is also
+     * done once the robot has passed the end, ex. after overshooting or being pushed past it
+    */
+    double endTolerance = 1;
+
+    /**
+     * Time in seconds after which following the path gives up, 0 for no timeout
+    */
+    double timeout = 0;
+};
+
+/**
+ * \brief The result of a pure pursuit step
+*/
+struct PursuitTarget {
+    double curvature = 0; // Curvature of the arc to the lookahead point in 1/inches, positive is clockwise
+    Vector2 lookahead; // The point being steered towards
+    int nearestIndex = 0; // Index of the nearest path point
+    double remaining = 0; // Distance left along the path in inches
+    bool done = false; // Whether the end of the path has been reached or passed
+};
+
+/**
+ * \brief Follows a path of points by steering along arcs to a point a lookahead distance ahead
+ * 
+ * The nearest point and lookahead point are searched for forward from where they were on the
+ * last step instead of over the whole path, so the cost of a step doesn't grow with the length
+ * of the path. This assumes the robot moves less than a few points per step, which holds for
+ * paths with points spaced an inch or so apart.
+*/
+class PurePursuit {
+    public:
+        /**
+         * Initializes the PurePursuit class
+         * @param path The points of the path in order, which must stay valid while following
+         * @param count The number of points in the path
+         * @param settings Lookahead and speed settings
+        */
+        PurePursuit(const Vector2* path, int count, PursuitSettings settings = PursuitSettings());
+
+        /**
+         * Run a step of pure pursuit
+         * @param position The robot's position
+         * @param heading The robot's heading in radians, clockwise from +y like TrackingData
+         * @param speed The robot's speed in inches per second, used for the lookahead distance
+         * @return The arc to follow
+        */
+        PursuitTarget step(Vector2 position, double heading, double speed);
+
+        /**
+         * Get the drive output for following a target, slowed down near the end of the path
+         * @param target The result of the last step
+        */
+        double getSpeed(const PursuitTarget& target) const;
+
+        /**
+         * Returns the total length of the path in inches
+        */
+        double getLength() const { return this->count > 0 ? this->arcLength[this->count - 1] : 0; };
+
+        /**
+         * Start following the path from the beginning again
+        */
+        void reset();
+
+    private:
+        const Vector2* path;
+        int count;
+        PursuitSettings settings;
+
+        std::vector<double> arcLength; // Distance along the path to each point
+
+        int nearestIndex = 0; // Nearest point at the last step
+        int lookaheadIndex = 0; // Start of the segment holding the lookahead point at the last step
+
+        /**
+         * Returns whether a position is past the end of the path, along the direction of its last segment
+        */
+        bool pastEnd(Vector2 position) const;
+};
@@ -0,0 +1,56 @@
+/**
+ * \file ramsete.h
+ *
+ * \brief Contains the RamseteTracker class, a nonlinear trajectory tracker for skid steer drivetrains.
+ *
+ * Doesn't depend on PROS so it can be simulated off the robot (see tools/trackerSim.cpp).
+*/
+
+#pragma once
+
+#include "control/trajectoryTracker.h"
+
+/**
+ * Default convergence gain in 1/inches squared. The common 2 / m^2 is only 0.0013 in inches, which
+ * corrects too slowly at V5 drive speeds, so this is tuned on tools/trackerSim.cpp instead
+*/
+#define RAMSETE_DEFAULT_B 0.02
+
+/**
+ * Default damping ratio
+*/
+#define RAMSETE_DEFAULT_ZETA 0.7
+
+/**
+ * \brief Tracks a trajectory by adding corrections for the error in the robot's frame to the
+ * trajectory's velocities
+ *
+ * Forward error speeds the robot up or slows it down, and heading and sideways error turn it
+ * back towards the trajectory. The correction gain grows with the trajectory's speed, so the
+ * robot converges at about the same rate per inch driven however fast it is going.
+*/
+class RamseteTracker : public TrajectoryTracker {
+    public:
+        /**
+         * Initializes the RamseteTracker class
+         * @param trackWidth Distance between the left and right wheels in inches (WHEELBASE in chassis.h)
+         * @param b Convergence gain in 1/inches squared, higher corrects more aggressively
+         * @param zeta Damping ratio in range (0, 1), higher damps the corrections more
+        */
+        RamseteTracker(double trackWidth, double b = RAMSETE_DEFAULT_B, double zeta = RAMSETE_DEFAULT_ZETA)
+            : trackWidth(trackWidth), b(b), zeta(zeta) {};
+
+        /**
+         * Work out the wheel velocities for the next step
+         * @param trajectory The trajectory being followed
+         * @param t Time since the trajectory started in seconds
+         * @param position The robot's position in inches
+         * @param heading The robot's heading in radians, clockwise from +y like TrackingData
+         * @return The velocities to drive each side at
+        */
+        WheelVelocities step(const Trajectory& trajectory, double t, Vector2 position, double heading) override;
+
+    private:
+        double trackWidth;
+        double b, zeta;
+};
@@ -0,0 +1,101 @@
+/**
+ * \file relayTuner.h
+ * 
+ * \brief Contains the RelayTuner class, which finds PID gains from a relay feedback experiment.
+ * 
+ * Doesn't depend on PROS so the same tuner can run against a plant model off the robot
+ * (see tools/pidTuneSim.cpp).
+*/
+
+#pragma once
+
+#include "control/PID.h"
+
+/**
+ * Number of half cycles at the start of an experiment to ignore while the oscillation settles
+*/
+#define RELAY_SKIPPED_HALF_CYCLES 2
+
+/**
+ * \brief Rules for turning the ultimate gain and period into PID gains
+*/
+enum TUNING_RULE {
+    ZIEGLER_NICHOLS, // Classic Ziegler-Nichols PID, fast with about 25% overshoot
+    SOME_OVERSHOOT, // Ziegler-Nichols variant with less overshoot
+    NO_OVERSHOOT // Ziegler-Nichols variant that should not overshoot, but is slower
+};
+
+/**
+ * \brief Drives a system with a relay (bang-bang output) around a setpoint to make it oscillate,
+ * then computes PID gains from the period and size of the oscillation (Astrom-Hagglund method)
+*/
+class RelayTuner {
+    public:
+        /**
+         * Initializes the RelayTuner class
+         * @param setpoint The sensor value to oscillate around
+         * @param amplitude The relay output, the system is driven with +amplitude or -amplitude
+         * @param hysteresis How far the sensor must cross the setpoint before the relay switches, filters out sensor noise
+         * @param cycles The number of full oscillations to average over
+        */
+        RelayTuner(double setpoint, double amplitude, double hysteresis = 0, int cycles = 4);
+
+        /**
+         * Run a step of the experiment
+         * @param sense New sensor data
+         * @param dt Time since the last step in seconds
+         * @return The output to drive the system with, 0 once done
+        */
+        double step(double sense, double dt);
+
+        /**
+         * Returns whether enough oscillations have been measured
+        */
+        bool isDone() const { return this->measuredCycles >= this->cycles; };
+
+        /**
+         * Returns the ultimate gain, the proportional gain at which the system oscillates forever
+        */
+        double getUltimateGain() const;
+
+        /**
+         * Returns the ultimate period in seconds, the period of that oscillation
+        */
+        double getUltimatePeriod() const;
+
+        /**
+         * Returns the PID gains (per second) found by the experiment, only valid once done
+         * @param rule The tuning rule to use
+        */
+        PIDInfo getGains(TUNING_RULE rule = ZIEGLER_NICHOLS) const;
+
+    private:
+        double setpoint, amplitude, hysteresis;
+        int cycles;
+
+        double output; // Current relay output
+        double time = 0; // Time since the start of the experiment in seconds
+        double peak, trough; // Largest and smallest sensor value in the current cycle
+        int halfCycles = 0; // Number of times the relay has switched
+
+        double lastRiseTime = -1; // Time of the last switch to positive output
+        double periodSum = 0; // Sum of measured periods
+        double peakToPeakSum = 0; // Sum of measured peak to peak heights
+        int measuredCycles = 0; // Number of periods measured
+};
+
+/**
+ * Save PID gains to a file, usually on the SD card
+ * @param path The file to save to
+ * @param gains The gains to save
+ * @return False if the file could not be written
+*/
+bool savePIDInfo(const char* path, PIDInfo gains);
+
+/**
+ * Load PID gains saved with savePIDInfo()
+ * @param path The file to load from
+ * @param gains Set to the loaded gains, left unchanged if loading fails
+ * @return False if the file does not exist or is not valid
+*/
+bool loadPIDInfo(const char* path, PIDInfo& gains);
@@ -0,0 +1,150 @@
+/**
+ * \file splinePath.h
+ *
+ * \brief Contains the SplinePath class, a smooth path through waypoints with headings.
+ *
+ * Doesn't depend on PROS so it can be benchmarked off the robot (see tools/splineBench.cpp).
+*/
+
+#pragma once
+
+#include <vector>
+#include "tracking/vector2.h"
+
+/**
+ * Number of arc length table entries per segment
+*/
+#define SPLINE_TABLE_RESOLUTION 32
+
+/**
+ * \brief The kind of curve fit between each pair of waypoints
+*/
+enum SPLINE_TYPE {
+    SPLINE_CUBIC_BEZIER, // Continuous heading, curvature can jump at waypoints
+    SPLINE_QUINTIC_HERMITE // Continuous heading and curvature
+};
+
+/**
+ * \brief A point the path passes through and the heading it passes through it at
+*/
+struct Waypoint {
+    Waypoint(Vector2 position = Vector2(), double heading = 0) : position(position), heading(heading) {};
+
+    /**
+     * Position in inches
+    */
+    Vector2 position;
+
+    /**
+     * Heading in radians, clockwise from +y like TrackingData, so 0 faces +y and pi / 2 faces +x
+    */
+    double heading;
+};
+
+/**
+ * \brief The state of the path at a distance along it
+*/
+struct PathSample {
+    Vector2 position; // Position in inches
+    double heading = 0; // Heading of the path in radians, clockwise from +y like TrackingData
+    double curvature = 0; // Curvature in 1/inches, positive turns clockwise
+    double distance = 0; // Distance along the path in inches
+};
+
+/**
+ * \brief A smooth path through waypoints made of one curve per pair of waypoints
+ *
+ * When the path is built, each segment is split into SPLINE_TABLE_RESOLUTION pieces and the
+ * length of each piece is integrated, along with the curvature at its start. Looking up the
+ * path by distance is then a binary search over the table instead of an integration.
+*/
+class SplinePath {
+    public:
+        /**
+         * Initializes the SplinePath class
+         * @param waypoints The waypoints to pass through in order
+         * @param count The number of waypoints, at least 2
+         * @param type The kind of curve to fit between waypoints
+         * @param tangentScale How far the path carries on in each waypoint's heading, as a fraction of
+         *                     the distance to the next waypoint. Larger values give wider curves
+        */
+        SplinePath(const Waypoint* waypoints, int count, SPLINE_TYPE type = SPLINE_QUINTIC_HERMITE, double tangentScale = 1.2);
+
+        /**
+         * Get the state of the path at a distance along it
+         * @param distance Distance along the path in inches, clamped to the ends of the path
+        */
+        PathSample sample(double distance) const;
+
+        /**
+         * Sample the path at even spacing from start to end, ex. for PurePursuit or planning speeds
+         * @param spacing Distance between samples in inches
+         * @return The samples, including both ends of the path
+        */
+        std::vector<PathSample> sampleEvenly(double spacing) const;
+
+        /**
+         * Get the positions of the path at even spacing, ready for DrivetrainPID::followPath()
+         * @param spacing Distance between points in inches
+        */
+        std::vector<Vector2> getPoints(double spacing) const;
+
+        /**
+         * Get the position of the path at a curve parameter, without using the arc length table
+         * @param parameter Segment index plus a fraction through that segment in range [0, 1]
+        */
+        Vector2 getPosition(double parameter) const;
+
+        /**
+         * Returns the total length of the path in inches
+        */
+        double getLength() const { return this->table.empty() ? 0 : this->table.back().distance; };
+
+        /**
+         * Returns the number of curves in the path
+        */
+        int getSegmentCount() const { return (int) this->segments.size(); };
+
+    private:
+        /**
+         * \brief One curve of the path as polynomials in a parameter u in range [0, 1]
+        */
+        struct Segment {
+            double x[6]; // Coefficients of x from u^0 to u^5
+            double y[6]; // Coefficients of y from u^0 to u^5
+        };
+
+        /**
+         * \brief An arc length table entry
+        */
+        struct TableEntry {
+            double distance; // Distance along the path
+            double parameter; // Segment index plus u
+            double curvature; // Curvature at this point
+        };
+
+        std::vector<Segment> segments;
+        std::vector<TableEntry> table;
+
+        /**
+         * Get the position and derivatives of the path at a parameter
+         * @param parameter Segment index plus u
+         * @param position Set to the position
+         * @param velocity Set to the first derivative by u
+         * @param acceleration Set to the second derivative by u
+        */
+        void evaluate(double parameter, Vector2& position, Vector2& velocity, Vector2& acceleration) const;
+
+        /**
+         * Get the speed of the path (length per unit u) at a parameter
+         * @param parameter Segment index plus u
+        */
+        double speed(double parameter) const;
+
+        /**
+         * Find the parameter at a distance along the path with a binary search of the table
+         * @param distance Distance along the path in inches, clamped to the ends of the path
+         * @param curvature Set to the curvature at that point
+        */
+        double parameterAt(double distance, double& curvature) const;
+};
@@ -0,0 +1,120 @@
+/**
+ * \file trajectory.h
+ *
+ * \brief Contains the Trajectory class, a path with planned velocities and timestamps.
+ *
+ * Doesn't depend on PROS so it can be benchmarked off the robot (see tools/trajectoryBench.cpp).
+*/
+
+#pragma once
+
+#include <vector>
+#include "control/splinePath.h"
+
+/**
+ * \brief Limits for planning the velocities along a path
+*/
+struct TrajectoryConstraints {
+    TrajectoryConstraints(double maxVelocity = 0, double maxAcceleration = 0, double trackWidth = 0)
+        : maxVelocity(maxVelocity), maxAcceleration(maxAcceleration), trackWidth(trackWidth) {};
+
+    /**
+     * Largest wheel velocity in inches per second
+    */
+    double maxVelocity;
+
+    /**
+     * Largest wheel acceleration in inches per second squared
+    */
+    double maxAcceleration;
+
+    /**
+     * Distance between the left and right wheels in inches (WHEELBASE in chassis.h), used to keep
+     * the outer wheel under the limits in turns
+    */
+    double trackWidth;
+
+    /**
+     * Velocity at the start of the path in inches per second
+    */
+    double startVelocity = 0;
+
+    /**
+     * Velocity at the end of the path in inches per second
+    */
+    double endVelocity = 0;
+};
+
+/**
+ * \brief The planned state of the robot at a point in time
+*/
+struct TrajectoryState {
+    Vector2 position; // Position in inches
+    double heading = 0; // Heading in radians, clockwise from +y like TrackingData (pi / 2 faces +x)
+    double curvature = 0; // Curvature in 1/inches, positive turns clockwise
+    double distance = 0; // Distance along the path in inches
+    double velocity = 0; // Velocity along the path in inches per second
+    double angularVelocity = 0; // Turn rate in radians per second, positive is clockwise
+    double acceleration = 0; // Acceleration along the path in inches per second squared
+    double time = 0; // Time since the start in seconds
+};
+
+/**
+ * \brief A path with the fastest velocities that stay within the limits, planned ahead of time
+ *
+ * Each sample's velocity is first capped so the outer wheel in a turn stays under the maximum
+ * velocity. A forward pass then limits how quickly the robot can speed up from the start, and a
+ * backward pass how late it can start slowing down for the end and for turns. The time to reach
+ * each sample follows from the velocities, so the trajectory can be looked up by time.
+*/
+class Trajectory {
+    public:
+        /**
+         * Initializes the Trajectory class with an empty trajectory
+        */
+        Trajectory() {};
+
+        /**
+         * Initializes the Trajectory class by planning velocities along a path
+         * @param path Samples of the path in order, ex. from SplinePath::sampleEvenly()
+         * @param constraints The velocity and acceleration limits
+        */
+        Trajectory(const std::vector<PathSample>& path, TrajectoryConstraints constraints) { this->plan(path, constraints); };
+
+        /**
+         * Plan velocities along a path, replacing the current trajectory
+         * @param path Samples of the path in order, ex. from SplinePath::sampleEvenly()
+         * @param constraints The velocity and acceleration limits
+        */
+        void plan(const std::vector<PathSample>& path, TrajectoryConstraints constraints);
+
+        /**
+         * Get the planned state at a time, between samples if needed
+         * @param t Time since the start in seconds, clamped to the ends of the trajectory
+        */
+        TrajectoryState sample(double t) const;
+
+        /**
+         * Get a planned sample
+         * @param index The index of the sample in range [0, size())
+        */
+        const TrajectoryState& operator[](int index) const { return this->states[index]; };
+
+        /**
+         * Returns the number of samples
+        */
+        int size() const { return (int) this->states.size(); };
+
+        /**
+         * Returns the time to drive the whole trajectory in seconds
+        */
+        double getDuration() const { return this->states.empty() ? 0 : this->states.back().time; };
+
+        /**
+         * Returns the length of the trajectory in inches
+        */
+        double getLength() const { return this->states.empty() ? 0 : this->states.back().distance; };
+
+    private:
+        std::vector<TrajectoryState> states;
+};
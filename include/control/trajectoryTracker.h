@@ -0,0 +1,42 @@
+/**
+ * \file trajectoryTracker.h
+ *
+ * \brief Contains the TrajectoryTracker interface, for controllers that drive a skid steer
+ * drivetrain along a Trajectory.
+*/
+
+#pragma once
+
+#include "control/trajectory.h"
+#include "tracking/pose2.h"
+
+/**
+ * \brief Velocities for each side of a skid steer drivetrain in inches per second
+*/
+struct WheelVelocities {
+    double left = 0;
+    double right = 0;
+};
+
+/**
+ * \brief A controller that keeps the robot on a trajectory, looked up by time
+*/
+class TrajectoryTracker {
+    public:
+        virtual ~TrajectoryTracker() {};
+
+        /**
+         * Clear any state kept between steps, called before following a new trajectory
+        */
+        virtual void reset() {};
+
+        /**
+         * Work out the wheel velocities for the next step
+         * @param trajectory The trajectory being followed
+         * @param t Time since the trajectory started in seconds
+         * @param position The robot's position in inches
+         * @param heading The robot's heading in radians, clockwise from +y like TrackingData (see Rotation2::fromHeading)
+         * @return The velocities to drive each side at
+        */
+        virtual WheelVelocities step(const Trajectory& trajectory, double t, Vector2 position, double heading) = 0;
+};
@@ -56,8 +56,39 @@ class SkidSteerDrive : public Drivetrain {
         * @param threshold Threshold of value before rounding to 0
         */
         void arcade(double forwardSpeed, double yaw, double threshold = 0) override;
+
+        /**
+         * Drives chassis forward at a velocity held by the motors' built-in velocity control
+         * @param velocity The velocity of the wheels in inches per second
+        */
+        void forwardVelocity(double velocity) override;
+
+        /**
+         * Rotate chassis clockwise at a velocity held by the motors' built-in velocity control
+         * @param velocity The velocity of the wheels in inches per second
+        */
+        void rotateVelocity(double velocity) override;
+
+        /**
+         * Drive each side of the chassis at a velocity held by the motors' built-in velocity control
+         * @param leftVelocity The velocity of the left wheels in inches per second
+         * @param rightVelocity The velocity of the right wheels in inches per second
+        */
+        void tankVelocity(double leftVelocity, double rightVelocity) override;
+
+        /**
+         * Returns the top velocity of the wheels in inches per second, from the gearset of the motors
+        */
+        double getMaxVelocity() override;
     
     private:
+        /**
+         * Convert a wheel velocity to the motor velocity used by move_velocity()
+         * @param velocity The velocity of the wheels in inches per second
+         * @return The velocity of the motors in rpm
+        */
+        int32_t toMotorVelocity(double velocity);
+
         /**
          * The top left motor of the drivetrain
         */
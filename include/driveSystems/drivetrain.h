@@ -50,4 +50,29 @@ class Drivetrain {
         * @param threshold Threshold of value before rounding to 0
         */
         virtual void arcade(double forwardSpeed, double yaw, double threshold = 0) = 0;
+
+        /**
+         * Drives chassis forward at a velocity held by the motors' built-in velocity control,
+         * so the speed doesn't change with battery voltage or load
+         * @param velocity The velocity of the wheels in inches per second
+        */
+        virtual void forwardVelocity(double velocity) = 0;
+
+        /**
+         * Rotate chassis clockwise at a velocity held by the motors' built-in velocity control
+         * @param velocity The velocity of the wheels in inches per second
+        */
+        virtual void rotateVelocity(double velocity) = 0;
+
+        /**
+         * Drive each side of the chassis at a velocity held by the motors' built-in velocity control
+         * @param leftVelocity The velocity of the left wheels in inches per second
+         * @param rightVelocity The velocity of the right wheels in inches per second
+        */
+        virtual void tankVelocity(double leftVelocity, double rightVelocity) = 0;
+
+        /**
+         * Returns the top velocity of the wheels in inches per second
+        */
+        virtual double getMaxVelocity() = 0;
 };
\ No newline at end of file
@@ -6,11 +6,62 @@
 
 #pragma once
 
+#include <initializer_list>
 #include "main.h"
 #include "drivetrain.h"
 #include "control/PID.h"
+#include "control/relayTuner.h"
+#include "control/ramsete.h"
+#include "driveSystems/motionHandle.h"
 #include "tracking.h"
 
+/**
+ * Number of asynchronous motions that can be queued or running at once
+*/
+#define MOTION_QUEUE_LENGTH 8
+
+/**
+ * Largest heading error in radians that a motion continuing from a chained motion steers out
+ * of while driving, larger errors are turned in place first
+*/
+#define CHAIN_TURN_IN_PLACE_ANGLE (M_PI / 4)
+
+/**
+ * Distance from the target in inches inside which moveToPoint() stops steering and only drives
+ * along its heading, since the direction to a target this close is mostly noise. The drive
+ * controller's error band is used instead if it is larger
+*/
+#define MOVE_TO_POINT_STEER_DISTANCE 2
+
+/**
+ * File on the SD card that tuned drive gains are saved to and loaded from
+*/
+#define DRIVE_GAINS_PATH "/usd/driveGains.txt"
+
+/**
+ * File on the SD card that tuned turn gains are saved to and loaded from
+*/
+#define TURN_GAINS_PATH "/usd/turnGains.txt"
+
+/**
+ * Longest time in seconds that a tuning experiment can run before giving up
+*/
+#define TUNING_TIMEOUT 15
+
+/**
+ * Fraction of the drivetrain's top velocity that full output asks for in OUTPUT_VELOCITY mode,
+ * which leaves the motors enough headroom to hold it on a low battery
+*/
+#define VELOCITY_MODE_MAX_FRACTION 0.7
+
+/**
+ * \brief What the output of the PID controllers drives
+*/
+enum DRIVE_OUTPUT_MODE {
+    OUTPUT_POWER, // Output is sent straight to the motors as power, so speed depends on battery voltage and load
+    OUTPUT_VELOCITY // Output is a velocity setpoint held by the motors' built-in velocity control (cascaded control)
+};
+
 /**
  * \brief Wrapper class on top of Drivetrain class to implement PID + Odom on any drivetrain
 */
@@ -45,11 +96,43 @@ class DrivetrainPID {
         */
         void moveToOrientation(Vector2 target, double angle);
 
+        /**
+         * Queue moveToOrientation() on the motion task and return without waiting
+         * @param target The position to reach as a Vector2
+         * @param angle The angle desired at the end of the action in radians
+         * @return A handle to wait on or cancel the motion
+        */
+        MotionHandle moveToOrientationAsync(Vector2 target, double angle);
+
         /**
          * Move to a specific point on the field
          * @param target The position to reach as a Vector2
+         * @param exitRadius Chain into the next motion once this close to the target in inches, or
+         * once past it, instead of stopping and settling, 0 to settle. The drive controller's
+         * settle timeout still applies while chaining
+         * @param minSpeed Smallest output in range [0, 127] to drive with while chaining, so speed
+         * is carried into the next motion
         */ 
-        void moveToPoint(Vector2 target);
+        void moveToPoint(Vector2 target, double exitRadius = 0, double minSpeed = 0);
+
+        /**
+         * Queue moveToPoint() on the motion task and return without waiting
+         * @param target The position to reach as a Vector2
+         * @param exitRadius Chain into the next motion once this close to the target in inches, 0 to settle
+         * @param minSpeed Smallest output in range [0, 127] to drive with while chaining
+         * @return A handle to wait on or cancel the motion
+        */
+        MotionHandle moveToPointAsync(Vector2 target, double exitRadius = 0, double minSpeed = 0);
+
+        /**
+         * Drive through a route of waypoints as one continuous motion, chaining through every
+         * waypoint but the last, which is settled on
+         * @param waypoints The points to drive through in order
+         * @param exitRadius Chain into the next waypoint once this close to the current one in inches
+         * @param minSpeed Smallest output in range [0, 127] to drive with before the last waypoint
+         * @return A handle to the motion to the last waypoint
+        */
+        MotionHandle moveThroughAsync(std::initializer_list<Vector2> waypoints, double exitRadius, double minSpeed);
 
         /**
          * Move and turn to a specific point and orientation relative to the bot's current
@@ -65,23 +148,234 @@ class DrivetrainPID {
         */ 
         void rotateTo(double angle);
 
+        /**
+         * Queue rotateTo() on the motion task and return without waiting
+         * @param angle The desired rotation in radians
+         * @return A handle to wait on or cancel the motion
+        */
+        MotionHandle rotateToAsync(double angle);
+
+        /**
+         * Follow a path with pure pursuit
+         * @param path The points of the path in order, spaced about an inch apart
+         * @param count The number of points in the path
+         * @param settings Lookahead and speed settings
+        */
+        void followPath(const Vector2* path, int count, PursuitSettings settings = PursuitSettings());
+
+        /**
+         * Queue followPath() on the motion task and return without waiting
+         * @param path The points of the path in order, which must stay valid until the motion is done
+         * @param count The number of points in the path
+         * @param settings Lookahead and speed settings
+         * @return A handle to wait on or cancel the motion, progress is by distance along the path
+        */
+        MotionHandle followPathAsync(const Vector2* path, int count, PursuitSettings settings = PursuitSettings());
+
+        /**
+         * Follow a trajectory in time, driving each side at the velocities from a tracker
+         * @param trajectory The trajectory to follow, ex. planned in initialize()
+         * @param tracker The controller that corrects for errors, nullptr to use RAMSETE
+        */
+        void followTrajectory(const Trajectory& trajectory, TrajectoryTracker* tracker = nullptr);
+
+        /**
+         * Queue followTrajectory() on the motion task and return without waiting
+         * @param trajectory The trajectory to follow, which must stay valid until the motion is done
+         * @param tracker The controller that corrects for errors, nullptr to use RAMSETE. Must stay valid
+         *                until the motion is done
+         * @return A handle to wait on or cancel the motion, progress is by time along the trajectory
+        */
+        MotionHandle followTrajectoryAsync(const Trajectory& trajectory, TrajectoryTracker* tracker = nullptr);
+
+        /**
+         * Stop the running motion and skip every queued motion
+        */
+        void cancelAll();
+
+        /**
+         * Returns whether any motion is queued or running
+        */
+        bool isMoving();
+
+        /**
+         * Take over the drivetrain from the motion task to drive it directly, ex. from ProfiledDrive.
+         * Waits for every queued motion to finish, then holds the motion task until the returned
+         * motion is released, so it counts towards isMoving() and can be stopped with cancelAll()
+         * @return A handle to the motion, check shouldStop() while driving and release() when done
+        */
+        MotionHandle acquire();
+
+        /**
+         * Set whether motions end as soon as their controller is close enough to chain the next
+         * motion (see SettleCriteria::chainBand) instead of waiting to settle
+         * @param earlyExit True to end motions early
+        */
+        void setEarlyExit(bool earlyExit) { this->earlyExit = earlyExit; };
+
+        /**
+         * Set what the output of the PID controllers drives. In OUTPUT_VELOCITY mode an output of
+         * 127 is VELOCITY_MODE_MAX_FRACTION of the drivetrain's top velocity, and the motors hold
+         * that velocity regardless of battery voltage. Gains tuned in one mode don't carry over to the other.
+         * @param mode The new output mode
+        */
+        void setOutputMode(DRIVE_OUTPUT_MODE mode) { this->outputMode = mode; };
+
+        /**
+         * Returns what the output of the PID controllers drives
+        */
+        DRIVE_OUTPUT_MODE getOutputMode() { return this->outputMode; };
+
+        /**
+         * Find drive gains by oscillating the robot back and forth around a point ahead of it (see
+         * RelayTuner), then use them for the drive controller and save them to the SD card
+         * @param distance The distance ahead of the robot to oscillate around in inches
+         * @param amplitude The output to oscillate with, in range [0, 127]
+         * @param rule The tuning rule used to turn the oscillation into gains
+         * @return True if the experiment finished, otherwise the gains are left unchanged
+        */
+        bool tuneDrive(double distance = 12, double amplitude = 60, TUNING_RULE rule = ZIEGLER_NICHOLS);
+
+        /**
+         * Find turn gains by oscillating the robot's heading around an angle (see RelayTuner), then
+         * use them for the turn controller and save them to the SD card
+         * @param angle The angle relative to the robot's current heading to oscillate around in radians
+         * @param amplitude The output to oscillate with, in range [0, 127]
+         * @param rule The tuning rule used to turn the oscillation into gains
+         * @return True if the experiment finished, otherwise the gains are left unchanged
+        */
+        bool tuneTurn(double angle = M_PI / 4, double amplitude = 40, TUNING_RULE rule = ZIEGLER_NICHOLS);
+
+        /**
+         * Load gains saved by tuneDrive() and tuneTurn() off the SD card, keeping the current gains
+         * of any controller that hasn't been tuned
+        */
+        void loadGains();
+
         /**
          * Returns the drive controller
         */ 
-        PIDController* getDriveController() { return driveController; };
+        PIDController* getDriveController() { return &driveController; };
 
         /**
          * Returns the turn controller
         */ 
-        PIDController* getTurnController() { return turnController; };
+        PIDController* getTurnController() { return &turnController; };
     
     private:
         // PID Drive Controller
-        PIDController* driveController;
+        PIDController driveController;
 
         // PID Turn Controller
-        PIDController* turnController;
+        PIDController turnController;
 
         // Pointer to drivetrain, note that it must refer to a derrived class
         Drivetrain* drivetrain;
+
+        // Whether motions end once close enough to chain the next motion
+        bool earlyExit = false;
+
+        // What the output of the PID controllers drives
+        DRIVE_OUTPUT_MODE outputMode = OUTPUT_POWER;
+
+        // Trajectory tracker used when followTrajectory() isn't given one
+        RamseteTracker ramsete;
+
+        // Ring of queued and running motions, motions [queueHead, queueTail) are in use
+        MotionState motions[MOTION_QUEUE_LENGTH];
+        std::atomic<uint32_t> queueHead{0}, queueTail{0};
+        uint32_t nextMotionId = 1;
+        pros::Mutex queueMutex;
+
+        // Task that runs queued motions, started with the first motion
+        pros::Task* motionTask = NULL;
+
+        // The motion currently running on the motion task, used to report progress and check for cancellation
+        MotionState* activeMotion = nullptr;
+
+        // Whether the last motion handed off while still moving, so the next one should carry on without stopping
+        bool carryingSpeed = false;
+
+        /**
+         * Add a motion to the queue, waiting for space if it is full
+         * @param command What the motion should do
+         * @return A handle to the queued motion
+        */
+        MotionHandle enqueue(const MotionCommand& command);
+
+        /**
+         * Runs queued motions one after another, forever
+         * @param param The DrivetrainPID to run motions for
+        */
+        static void runMotions(void* param);
+
+        /**
+         * Returns whether the running motion has been cancelled
+        */
+        bool motionCancelled() { return this->activeMotion != nullptr && this->activeMotion->isCancelled(); };
+
+        /**
+         * Blocking body of moveToPoint(), run on the motion task
+        */
+        void runMoveToPoint(Vector2 target, double exitRadius = 0, double minSpeed = 0);
+
+        /**
+         * Blocking body of followPath(), run on the motion task
+        */
+        void runFollowPath(const MotionCommand& command);
+
+        /**
+         * Blocking body of followTrajectory(), run on the motion task
+        */
+        void runFollowTrajectory(const MotionCommand& command);
+
+        /**
+         * Drive each side with controller outputs, using the output mode
+         * @param left The left output in range [-127, 127]
+         * @param right The right output in range [-127, 127]
+        */
+        void driveTank(double left, double right);
+
+        /**
+         * Drive forward while turning with controller outputs, using the output mode
+         * @param forward The forward output in range [-127, 127]
+         * @param turn The clockwise turn output in range [-127, 127]
+        */
+        void driveArcade(double forward, double turn);
+
+        /**
+         * Blocking body of rotateTo(), run on the motion task
+        */
+        void runRotateTo(double angle);
+
+        /**
+         * Drive forward with a controller output, using the output mode
+         * @param output The output in range [-127, 127]
+        */
+        void driveForward(double output);
+
+        /**
+         * Rotate clockwise with a controller output, using the output mode
+         * @param output The output in range [-127, 127]
+        */
+        void driveRotate(double output);
+
+        /**
+         * Run a relay experiment, driving the drivetrain with the tuner's output
+         * @param motion The motion from acquire() the experiment runs as, which stops it if cancelled
+         * @param tuner The tuner to run
+         * @param sense Returns the current sensor value
+         * @param drive Drives the drivetrain with an output
+         * @return True if the experiment finished before the timeout and wasn't cancelled
+        */
+        template <typename Sense, typename Drive>
+        bool runTuner(const MotionHandle& motion, RelayTuner& tuner, Sense sense, Drive drive);
+
+        /**
+         * Check whether a motion run by a controller should end
+         * @param controller The controller running the motion
+        */
+        bool motionDone(PIDController& controller) {
+            return controller.isDone() || (this->earlyExit && controller.isCloseEnough());
+        };
 };
\ No newline at end of file
@@ -0,0 +1,178 @@
+/**
+ * \file motionHandle.h
+ * 
+ * \brief Contains the MotionState and MotionHandle classes used by asynchronous DrivetrainPID motions.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include "tracking/vector2.h"
+#include "control/purePursuit.h"
+#include "control/trajectoryTracker.h"
+
+/**
+ * Time in ms between checks while waiting on a motion
+*/
+#define MOTION_WAIT_PERIOD 10
+
+/**
+ * \brief Types of motion that can run on the motion task
+*/
+enum MOTION_TYPE {
+    MOTION_MOVE_TO_POINT,
+    MOTION_ROTATE_TO,
+    MOTION_MOVE_TO_ORIENTATION,
+    MOTION_FOLLOW_PATH,
+    MOTION_FOLLOW_TRAJECTORY,
+    MOTION_EXTERNAL // Driven by code outside the motion task, which holds the task until it releases the motion
+};
+
+/**
+ * \brief What a motion should do, only the fields used by its type are set
+*/
+struct MotionCommand {
+    MOTION_TYPE type = MOTION_MOVE_TO_POINT;
+    Vector2 target; // Position to reach
+    double angle = 0; // Angle to reach in radians
+    double exitRadius = 0; // Distance from the target at which a chained motion hands off, 0 to settle instead
+    double minSpeed = 0; // Smallest output a chained motion drives with
+    const Vector2* path = nullptr; // Path to follow, owned by the caller
+    int pathLength = 0; // Number of points in the path
+    PursuitSettings pursuit; // Settings for following the path
+    const Trajectory* trajectory = nullptr; // Trajectory to follow, owned by the caller
+    TrajectoryTracker* tracker = nullptr; // Controller for following the trajectory, owned by the caller
+};
+
+/**
+ * \brief A queued or running motion, shared between the motion task and handles to it
+*/
+class MotionState {
+    public:
+        /**
+         * Identifies the motion, so a handle can tell when its slot has been reused by a newer
+         * motion. Always set before done is cleared.
+        */
+        std::atomic<uint32_t> id{0};
+
+        /**
+         * Whether the motion has finished, been cancelled or been skipped
+        */
+        std::atomic<bool> done{true};
+
+        /**
+         * Id of the last motion in this slot that was asked to stop. Storing the id rather than a
+         * flag means a cancel that races with the slot being reused can't stop the newer motion,
+         * and a new motion never has to clear it
+        */
+        std::atomic<uint32_t> cancelledId{0};
+
+        /**
+         * Whether the motion task has started the motion
+        */
+        std::atomic<bool> started{false};
+
+        /**
+         * Whether the code driving a MOTION_EXTERNAL motion has handed the motion task back
+        */
+        std::atomic<bool> released{false};
+
+        /**
+         * Inches driven since the motion started
+        */
+        std::atomic<float> distance{0};
+
+        /**
+         * Fraction of the motion completed in range [0, 1], by distance for motions that drive
+         * and by angle for turns
+        */
+        std::atomic<float> progress{0};
+
+        /**
+         * What the motion should do, only written before the motion is queued
+        */
+        MotionCommand command;
+
+        /**
+         * Returns whether the motion in this slot has been asked to stop
+        */
+        bool isCancelled() const { return this->cancelledId == this->id; };
+};
+
+/**
+ * \brief Handle to a motion running on the motion task, returned by DrivetrainPID's async methods
+ * 
+ * Handles are cheap to copy. Once the motion is done, the handle stays done even after its
+ * slot is reused by a newer motion.
+*/
+class MotionHandle {
+    public:
+        /**
+         * Initializes the MotionHandle class, use DrivetrainPID's async methods instead
+         * @param state The state of the motion
+         * @param id The id of the motion
+        */
+        MotionHandle(MotionState* state = nullptr, uint32_t id = 0) : state(state), id(id) {};
+
+        /**
+         * Returns whether the motion has finished, been cancelled or been skipped
+        */
+        bool isDone() const;
+
+        /**
+         * Returns whether the motion task has started the motion and it isn't done yet
+        */
+        bool isRunning() const;
+
+        /**
+         * Returns whether code driving the motion should stop, because it has been cancelled or is already done
+        */
+        bool shouldStop() const;
+
+        /**
+         * Returns the inches driven since the motion started, 0 while queued
+        */
+        double getDistance() const;
+
+        /**
+         * Returns the fraction of the motion completed in range [0, 1]
+        */
+        double getProgress() const;
+
+        /**
+         * Block until the motion is done
+        */
+        void wait() const;
+
+        /**
+         * Block until the robot has driven a distance since the motion started, or the motion is done
+         * @param distance The distance in inches
+        */
+        void waitUntilDistance(double distance) const;
+
+        /**
+         * Block until a fraction of the motion has been completed, or the motion is done
+         * @param progress The fraction in range [0, 1]
+        */
+        void waitUntilProgress(double progress) const;
+
+        /**
+         * Stop the motion if it is running, or skip it if it is queued
+        */
+        void cancel();
+
+        /**
+         * Hand the motion task back once done driving a motion from DrivetrainPID::acquire()
+        */
+        void release();
+
+    private:
+        MotionState* state;
+        uint32_t id;
+
+        /**
+         * Returns whether the state still belongs to this motion
+        */
+        bool isCurrent() const { return this->state != nullptr && this->state->id == this->id; };
+};
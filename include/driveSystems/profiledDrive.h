@@ -0,0 +1,142 @@
+/**
+ * \file profiledDrive.h
+ * 
+ * \brief Contains headers for the ProfiledDrive class, which moves a drivetrain along motion profiles with feedforward + PID.
+*/
+
+#pragma once
+
+#include "main.h"
+#include "drivetrain.h"
+#include "driveSystems/drivetrainPID.h"
+#include "control/profileFollower.h"
+#include "tracking.h"
+
+/**
+ * Period of the profiled motion loops in ms
+*/
+#define PROFILED_DRIVE_PERIOD 10
+
+/**
+ * \brief The settings for one axis (driving or turning) of a ProfiledDrive
+*/
+struct ProfiledAxis {
+    /**
+     * Initializes the ProfiledAxis struct
+     * @param constraints The velocity, acceleration and jerk limits of the profiles
+     * @param feedforward Feedforward constants, with output in range [-127, 127]
+     * @param constants PID gain constants (per second) for correcting position error
+     * @param criteria Conditions for a motion to be settled
+    */
+    ProfiledAxis(ProfileConstraints constraints, Feedforward feedforward, PIDInfo constants, SettleCriteria criteria)
+        : constraints(constraints), feedforward(feedforward), constants(constants), criteria(criteria) {};
+
+    ProfileConstraints constraints;
+    Feedforward feedforward;
+    PIDInfo constants;
+    SettleCriteria criteria;
+};
+
+/**
+ * \brief Drives a drivetrain along motion profiles, using feedforward for the motion
+ * and PID to correct position error. Same interface as DrivetrainPID, which it can be used
+ * next to, but reaches targets faster without overshooting since the output never saturates
+ * on a large error. Each motion takes over DrivetrainPID's motion task while it runs (see
+ * DrivetrainPID::acquire()), so it waits for queued motions and stops on cancelAll().
+*/
+class ProfiledDrive {
+    public:
+        /**
+         * Initializes the ProfiledDrive class
+         * @param drivetrain The type of drivetrain (ex. SkidSteerDrive) used, which is not owned by this class
+         * @param motions The DrivetrainPID driving the same drivetrain, whose motion queue motions run through
+         * @param drive Settings for driving, in inches
+         * @param turn Settings for turning, in radians
+        */
+        ProfiledDrive(Drivetrain* drivetrain, DrivetrainPID* motions, ProfiledAxis drive, ProfiledAxis turn);
+
+        /**
+         * Turn to face a point, then drive straight to it
+         * @param target The position to reach as a Vector2
+        */
+        void moveToPoint(Vector2 target);
+
+        /**
+         * Rotate the robot to the desired orientation
+         * @param angle The desired rotation in radians
+        */
+        void rotateTo(double angle);
+
+        /**
+         * Turn to the angle needed to reach a position, drive to the position, and then turn to the desired angle
+         * @param target The position to reach as a Vector2
+         * @param angle The angle desired at the end of the action in radians
+        */
+        void moveToOrientation(Vector2 target, double angle);
+
+        /**
+         * Drive straight forward or backward
+         * @param distance The distance to drive in inches, negative to drive backward
+        */
+        void driveDistance(double distance);
+
+        /**
+         * Drive straight along a profile built ahead of time, ex. in initialize()
+         * @param profile The profile to follow in inches, negative distances drive backward
+        */
+        void followDriveProfile(const MotionProfile& profile);
+
+        /**
+         * Turn in place along a profile built ahead of time, ex. in initialize()
+         * @param profile The profile to follow in radians relative to the current heading, positive is clockwise
+        */
+        void followTurnProfile(const MotionProfile& profile);
+
+    private:
+        // Pointer to drivetrain, note that it must refer to a derrived class
+        Drivetrain* drivetrain;
+
+        // DrivetrainPID whose motion task is held while moving
+        DrivetrainPID* motions;
+
+        // The running motion, checked for cancellation by every follower loop
+        MotionHandle motion;
+
+        // Settings for each axis
+        ProfiledAxis drive, turn;
+
+        // Followers for each axis
+        ProfileFollower driveFollower, turnFollower;
+
+        // Profiles for motions built on the fly
+        MotionProfile driveProfile, turnProfile;
+
+        /**
+         * Blocking body of moveToPoint(), run while holding the motion task
+        */
+        void runMoveToPoint(Vector2 target);
+
+        /**
+         * Blocking body of rotateTo(), run while holding the motion task
+        */
+        void runRotateTo(double angle);
+
+        /**
+         * Blocking body of followDriveProfile(), run while holding the motion task
+        */
+        void runDriveProfile(const MotionProfile& profile);
+
+        /**
+         * Blocking body of followTurnProfile(), run while holding the motion task
+        */
+        void runTurnProfile(const MotionProfile& profile);
+
+        /**
+         * Run a follower until its motion is done or cancelled
+         * @param follower The follower to run
+         * @param sense Returns the current sensor value
+         * @param output Drives the drivetrain with an output
+        */
+        template <typename Sense, typename Output>
+        void follow(ProfileFollower& follower, Sense sense, Output output);
+};
@@ -0,0 +1,139 @@
+/**
+ * \file fastTrig.h
+ * 
+ * \brief Fast polynomial approximations of sin, cos and atan2 for control loops.
+ * 
+ * newlib's libm computes these in software to full double precision, which is more than
+ * any sensor on the robot can use. These approximations use minimax polynomials and are
+ * accurate to well below anything measurable:
+ * - fastSin / fastCos / fastSinCos: max absolute error 2.68e-9 for |x| <= 1000 rad
+ * - fastAtan2: max absolute error 8.07e-9 rad
+ * 
+ * Both bounds are checked by tools/fastTrigCheck.cpp.
+ * 
+ * Each call site picks between these and libm at compile time with Trig<TRIG_FAST> or
+ * Trig<TRIG_LIBM>, usually through a per-subsystem macro such as TRACKING_TRIG_MODE.
+*/
+
+#pragma once
+
+#include <math.h>
+
+/**
+ * \brief The trig implementations to choose from
+*/
+enum TRIG_MODE {
+    TRIG_LIBM, // Full precision newlib functions
+    TRIG_FAST  // Polynomial approximations from this file
+};
+
+/**
+ * Trig implementation used by odometry and tracking data
+*/
+#ifndef TRACKING_TRIG_MODE
+#define TRACKING_TRIG_MODE TRIG_FAST
+#endif
+
+/**
+ * Trig implementation used by the drivetrain controllers
+*/
+#ifndef CONTROL_TRIG_MODE
+#define CONTROL_TRIG_MODE TRIG_FAST
+#endif
+
+/**
+ * Compute the sine and cosine of an angle together, sharing the range reduction
+ * @param x The angle in radians
+ * @param s Set to the sine of the angle
+ * @param c Set to the cosine of the angle
+*/
+inline void fastSinCos(double x, double& s, double& c) {
+    // Reduce to r in [-pi/4, pi/4] with x = r + k * pi/2, subtracting pi/2 in two parts to keep precision
+    double k = nearbyint(x * M_2_PI);
+    double r = (x - k * 1.5707963267341256) - k * 6.077100506506192e-11;
+    double r2 = r * r;
+
+    // Minimax polynomials for sin and cos on [-pi/4, pi/4]
+    double sr = r + r * r2 * (-1.6666654611e-1 + r2 * (8.3321608736e-3 + r2 * -1.9515295891e-4));
+    double cr = 1 - 0.5 * r2 + r2 * r2 * (4.166664568298827e-2 + r2 * (-1.388731625493765e-3 + r2 * 2.443315711809948e-5));
+
+    // Rotate the result into the right quadrant
+    switch (((long) k) & 3) {
+        case 0: s = sr;  c = cr;  break;
+        case 1: s = cr;  c = -sr; break;
+        case 2: s = -sr; c = -cr; break;
+        default: s = -cr; c = sr; break;
+    }
+}
+
+/**
+ * Compute the sine of an angle
+ * @param x The angle in radians
+*/
+inline double fastSin(double x) {
+    double s, c;
+    fastSinCos(x, s, c);
+    return s;
+}
+
+/**
+ * Compute the cosine of an angle
+ * @param x The angle in radians
+*/
+inline double fastCos(double x) {
+    double s, c;
+    fastSinCos(x, s, c);
+    return c;
+}
+
+/**
+ * Compute the angle of the point (x, y) from the positive x axis
+ * @param y The y value
+ * @param x The x value
+ * @return The angle in radians in the range [-pi, pi]
+*/
+inline double fastAtan2(double y, double x) {
+    double ax = fabs(x);
+    double ay = fabs(y);
+    if (ax == 0 && ay == 0) {
+        return 0;
+    }
+
+    // Get atan(t) with t in [0, 1] by swapping x and y when needed
+    bool swap = ay > ax;
+    double t = swap ? ax / ay : ay / ax;
+
+    // Reduce further to |t| <= tan(pi/8) using atan(t) = pi/4 + atan((t - 1) / (t + 1))
+    double offset = 0;
+    if (t > 0.4142135623730950) {
+        t = (t - 1) / (t + 1);
+        offset = M_PI_4;
+    }
+
+    // Minimax polynomial for atan on [-tan(pi/8), tan(pi/8)]
+    double z = t * t;
+    double a = offset + t + t * z * (-3.33329491539e-1 + z * (1.99777106478e-1 + z * (-1.38776856032e-1 + z * 8.05374449538e-2)));
+
+    // Undo the swap and move into the right quadrant
+    if (swap) a = M_PI_2 - a;
+    if (x < 0) a = M_PI - a;
+    return y < 0 ? -a : a;
+}
+
+/**
+ * \brief Trig functions using the implementation chosen at compile time
+*/
+template <TRIG_MODE mode>
+struct Trig {
+    static double sin(double x) { return mode == TRIG_FAST ? fastSin(x) : ::sin(x); };
+    static double cos(double x) { return mode == TRIG_FAST ? fastCos(x) : ::cos(x); };
+    static double atan2(double y, double x) { return mode == TRIG_FAST ? fastAtan2(y, x) : ::atan2(y, x); };
+    static void sincos(double x, double& s, double& c) {
+        if (mode == TRIG_FAST) {
+            fastSinCos(x, s, c);
+        } else {
+            s = ::sin(x);
+            c = ::cos(x);
+        }
+    };
+};
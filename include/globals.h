@@ -12,8 +12,11 @@
 #include "main.h"
 #include "driveSystems/SkidSteerDrive.h"
 #include "driveSystems/drivetrainPID.h"
+#include "driveSystems/profiledDrive.h"
+#include "control/mpcTracker.h"
 #include "displayController.h"
 #include "tracking.h"
+#include "tracking/poseHistory.h"
 
 // Motors
 
@@ -35,9 +38,12 @@ extern pros::ADIEncoder rEnc; // Right encoder
 // Drivetrain
 extern SkidSteerDrive* driveTrain;
 extern DrivetrainPID driveTrainPID;
+extern ProfiledDrive profiledDrive;
+extern MPCTracker<MPC_DEFAULT_HORIZON> mpcTracker; // Alternative to RAMSETE for followTrajectory()
 
 // Odometry tracking
 extern TrackingData trackingData;
+extern PoseHistory poseHistory;
 
 // Display controller
 extern DisplayController display;
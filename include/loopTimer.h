@@ -0,0 +1,136 @@
+/**
+ * \file loopTimer.h
+ * 
+ * \brief Contains the LoopTimer class used to run a task loop at a fixed period.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "seqLock.h"
+
+/**
+ * The smallest period (in ms) that a LoopTimer can be set to
+*/
+#define LOOP_TIMER_MIN_PERIOD 2
+
+/**
+ * \brief Timing statistics of a fixed-rate loop, all times are in microseconds
+*/
+struct LoopStats {
+    /**
+     * The target period of the loop
+    */
+    uint32_t targetPeriod = 0;
+
+    /**
+     * The shortest period measured between two iterations
+    */
+    uint32_t minPeriod = 0;
+
+    /**
+     * The longest period measured between two iterations
+    */
+    uint32_t maxPeriod = 0;
+
+    /**
+     * The mean period over all measured iterations
+    */
+    uint32_t meanPeriod = 0;
+
+    /**
+     * The largest difference between a measured period and the target period
+    */
+    uint32_t maxJitter = 0;
+
+    /**
+     * The number of iterations whose work took longer than the target period
+    */
+    uint32_t overruns = 0;
+
+    /**
+     * The number of measured iterations
+    */
+    uint32_t iterations = 0;
+};
+
+/**
+ * \brief Schedules a loop at a fixed period using pros::Task::delay_until,
+ * and measures how well that period is being held.
+ * 
+ * The statistics are published through a SeqLock after every iteration, so getStats() can be
+ * called from any task. Every other method must be called from the loop's own task.
+*/
+class LoopTimer {
+    public:
+        /**
+         * Initializes the LoopTimer class with a period
+         * @param period The period of the loop in ms, clamped to LOOP_TIMER_MIN_PERIOD
+        */
+        LoopTimer(uint32_t period);
+
+        /**
+         * Set the period of the loop, takes effect on the next wait()
+         * @param period The new period in ms, clamped to LOOP_TIMER_MIN_PERIOD
+        */
+        void setPeriod(uint32_t period);
+
+        /**
+         * Returns the period of the loop in ms
+        */
+        uint32_t getPeriod() { return this->period; };
+
+        /**
+         * Start the schedule from the current time. Call once right before entering the loop.
+        */
+        void start();
+
+        /**
+         * Sleep until the start of the next period and record the timing of the iteration
+         * that just finished. Call once at the end of every iteration.
+        */
+        void wait();
+
+        /**
+         * Get the timing statistics measured since start() or the last resetStats(), safe to
+         * call from any task
+         * @return The timing statistics as LoopStats, all from the same iteration
+        */
+        LoopStats getStats();
+
+        /**
+         * Clear all timing statistics
+        */
+        void resetStats();
+
+    private:
+        /**
+         * The period of the loop in ms
+        */
+        uint32_t period;
+
+        /**
+         * The time the task last woke up at in ms, used by delay_until
+        */
+        uint32_t wakeTime = 0;
+
+        /**
+         * The time the current iteration started at in us
+        */
+        uint64_t iterationStart = 0;
+
+        /**
+         * The sum of all measured periods in us, used for the mean
+        */
+        uint64_t periodSum = 0;
+
+        /**
+         * The statistics measured so far, only touched by the loop's task
+        */
+        LoopStats stats;
+
+        /**
+         * Copy of the statistics published after every iteration for other tasks
+        */
+        SeqLock<LoopStats> publishedStats;
+};
@@ -0,0 +1,79 @@
+/**
+ * \file seqLock.h
+ * 
+ * \brief Contains the SeqLock class used to share data between tasks without a mutex.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * \brief Sequence lock to publish a value from one writer task to any number of reader tasks.
+ * 
+ * The writer never blocks, and readers retry their copy if the writer was in the middle
+ * of an update, so a reader always gets a value from a single write. Only one task
+ * may ever call write().
+*/
+template <typename T>
+class SeqLock {
+    public:
+        /**
+         * Initializes the SeqLock class with a value
+         * @param value The initial value
+        */
+        SeqLock(const T& value) : value(value) {};
+
+        /**
+         * Initializes the SeqLock class with a default constructed value
+        */
+        SeqLock() {};
+
+        /**
+         * Publish a new value, never blocks
+         * @param newValue The new value
+        */
+        void write(const T& newValue) {
+            uint32_t seq = this->sequence.load(std::memory_order_relaxed);
+
+            // An odd sequence marks the value as being written
+            this->sequence.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            this->value = newValue;
+
+            // Back to even once the value is complete
+            this->sequence.store(seq + 2, std::memory_order_release);
+        }
+
+        /**
+         * Get a consistent copy of the latest value
+         * @return The latest value
+        */
+        T read() const {
+            T copy;
+            uint32_t start, end;
+
+            do {
+                start = this->sequence.load(std::memory_order_acquire);
+                copy = this->value;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                end = this->sequence.load(std::memory_order_relaxed);
+                // Retry if a write was in progress or happened during the copy
+            } while ((start & 1) || start != end);
+
+            return copy;
+        }
+
+    private:
+        /**
+         * Write sequence number, odd while a write is in progress
+        */
+        std::atomic<uint32_t> sequence{0};
+
+        /**
+         * The published value
+        */
+        T value;
+};
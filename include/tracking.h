@@ -11,6 +11,11 @@
 #ifndef _TRACKING_H_
 #define _TRACKING_H_
 
+#include "loopTimer.h"
+#include "seqLock.h"
+#include "tracking/vector2.h"
+#include "tracking/pose2.h"
+
 /**
  * Converts radians to degrees
  * @param r Radian unit to convert
@@ -24,79 +29,46 @@ double radToDeg(double r);
 double degToRad(double d);
 
 /**
- * \brief Class object to represent a vector within a 2 dimensional space
+ * \brief A single consistent reading of the position info of the robot
 */
-class Vector2 {
-    public:
-        /**
-         * Initializes the Vector2 class with preloaded x and y values
-         * @param x x value of the vector
-         * @param y y value of the vector
-        */
-        Vector2(double x, double y);
-
-        /**
-         * Initializes the Vector2 class with default values (0, 0)
-        */
-        Vector2();
-
-
-        /**
-         * Returns the x value of the vector
-        */
-        double getX() { return this->x; };
-
-        /**
-         * Returns the y value of the vector
-        */
-        double getY() { return this->y; };
-
-
-        /**
-         * Returns the magnitude of the vector
-        */
-        double getMagnitude();
-
-        /**
-         * Returns the angle of the vector
-        */
-        double getAngle();
-
-
-        /**
-         * Normalize the vector (change the length of the vector to 1 while retaining the direction)
-         * @return Normalized version of the vector
-        */
-        Vector2 normalize(); 
-
-        // Arithmetic functions
-
-        /**
-         * Simple vector addition
-        */
-        friend Vector2 operator+(const Vector2 &v1, const Vector2 &v2);
-        /**
-         * Simple vector subtraction
-        */
-        friend Vector2 operator-(const Vector2 &v1, const Vector2 &v2);
-        /**
-         * Scalar and vector multiplication
-        */
-        friend Vector2 operator*(const Vector2 &v1, const double scalar);
-    
-    private:
-        /**
-         * The x value of the vector
-        */
-        double x;
-        /**
-         * The y value of the vector
-        */
-        double y;
+struct PoseSnapshot {
+    /**
+     * x value of the location
+    */
+    double x = 0;
+
+    /**
+     * y value of the location
+    */
+    double y = 0;
+
+    /**
+     * Heading (angle) of the robot in radians, clockwise from +y like the IMU. At 0 the robot
+     * faces +y, and at pi / 2 it faces +x
+    */
+    double heading = 0;
+
+    /**
+     * Cosine of the heading, computed once per update
+    */
+    double cosHeading = 1;
+
+    /**
+     * Sine of the heading, computed once per update
+    */
+    double sinHeading = 0;
+
+    /**
+     * Time of the update in microseconds since the program started
+    */
+    uint64_t timestamp = 0;
 };
 
 /**
  * \brief Class object to represent the position info of the robot
+ * 
+ * Updated by the tracking task and read by any other task. Updates never block, and
+ * every read returns values from the same update.
 */
 class TrackingData {
     public:
@@ -108,6 +80,19 @@ class TrackingData {
         */
         TrackingData(double x, double y, double h);
 
+        /**
+         * Get the position and heading from the same update
+         * @return The latest position info as a PoseSnapshot
+        */
+        PoseSnapshot getSnapshot() const; 
+
+        /**
+         * Get the position and heading from the same update, reusing the sine and cosine
+         * of the heading computed by the update
+         * @return The latest position info as a Pose2, rotating from the robot's frame to the field's
+        */
+        Pose2 getPose() const;
+
         /**
          * Get the heading angle of the current tracking data
          * @return The heading angle of the robot
@@ -142,13 +127,9 @@ class TrackingData {
 
     private:
         /**
-         * Current position of the robot represented as a Vector2 (units: ft)
+         * Current position (units: ft) and heading of the robot
         */
-        Vector2 pos;
-        /**
-         * Current heading (angle) of the robot
-        */
-        double heading;
+        SeqLock<PoseSnapshot> pose;
 };
 
 /**
@@ -170,6 +151,45 @@ Vector2 toLocalCoordinates(Vector2 vec);
 */
 Vector2 toGlobalCoordinates(Vector2 vec);
 
+/**
+ * Convert vector to local coordinates of a specific pose, so several conversions in the
+ * same control loop iteration can share one pose and its sine and cosine
+ * @param vec Vector to convert
+ * @param pose The pose to use, ex. from trackingData.getPose()
+*/
+Vector2 toLocalCoordinates(Vector2 vec, const Pose2& pose);
+
+/**
+ * Convert vector to global coordinates from the local coordinates of a specific pose
+ * @param vec Vector to convert
+ * @param pose The pose to use, ex. from trackingData.getPose()
+*/
+Vector2 toGlobalCoordinates(Vector2 vec, const Pose2& pose);
+
+/**
+ * Set the period of the tracking loop, takes effect on the next iteration
+ * @param period The new period in ms, can't be lower than LOOP_TIMER_MIN_PERIOD
+*/
+void setTrackingPeriod(uint32_t period);
+
+/**
+ * Get the timing statistics of the tracking loop
+ * @return The timing statistics as LoopStats
+*/
+LoopStats getTrackingStats();
+
+/**
+ * Start recording raw tracking sensor data to a file, which can be replayed off the robot
+ * with tools/odomReplay.cpp. The recording starts on the next iteration of the tracking task.
+ * @param path The file to record to, ex. "/usd/odom.bin". Must stay valid until the recording starts.
+*/
+void startTrackingRecording(const char* path);
+
+/**
+ * Stop recording raw tracking sensor data, closing the file
+*/
+void stopTrackingRecording();
+
 /**
  * Main robot tracking function, runs as a PROs task
  * @param param Placeholder parameter required for PROs tasks
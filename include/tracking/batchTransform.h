@@ -0,0 +1,49 @@
+/**
+ * \file batchTransform.h
+ * 
+ * \brief Functions to convert many points between the field frame and the robot frame at once.
+ * 
+ * Points are stored as structure-of-arrays (separate x and y buffers) of floats, which lets the
+ * V5 convert 4 points per instruction using NEON. Builds without NEON (ex. on a computer) use the
+ * scalar versions.
+*/
+
+#pragma once
+
+#include "tracking/pose2.h"
+
+/**
+ * Convert points from the global (field) frame into the local frame of a pose, ex. waypoints
+ * into the robot's frame. Same math as Pose2::toLocal().
+ * @param x x values of the points
+ * @param y y values of the points
+ * @param outX Set to the converted x values, can be the same buffer as x
+ * @param outY Set to the converted y values, can be the same buffer as y
+ * @param count Number of points
+ * @param pose The pose whose frame to convert into, ex. from trackingData.getPose()
+*/
+void batchToLocal(const float* x, const float* y, float* outX, float* outY, int count, const Pose2& pose);
+
+/**
+ * Convert points from the local frame of a pose into the global (field) frame.
+ * Same math as Pose2::toGlobal().
+ * @param x x values of the points
+ * @param y y values of the points
+ * @param outX Set to the converted x values, can be the same buffer as x
+ * @param outY Set to the converted y values, can be the same buffer as y
+ * @param count Number of points
+ * @param pose The pose whose frame the points are in
+*/
+void batchToGlobal(const float* x, const float* y, float* outX, float* outY, int count, const Pose2& pose);
+
+/**
+ * Scalar version of batchToLocal(), used when NEON isn't available and for the points left over
+ * after the last group of 4
+*/
+void batchToLocalScalar(const float* x, const float* y, float* outX, float* outY, int count, const Pose2& pose);
+
+/**
+ * Scalar version of batchToGlobal(), used when NEON isn't available and for the points left over
+ * after the last group of 4
+*/
+void batchToGlobalScalar(const float* x, const float* y, float* outX, float* outY, int count, const Pose2& pose);
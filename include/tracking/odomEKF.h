@@ -0,0 +1,112 @@
+/**
+ * \file odomEKF.h
+ * 
+ * \brief Contains the OdomEKF class, which fuses tracking wheel odometry with the IMU.
+*/
+
+#pragma once
+
+#include "tracking.h"
+
+/**
+ * \brief Extended Kalman filter that fuses tracking wheel odometry with IMU heading and rate.
+ * 
+ * The state is [x, y, angle, angular velocity], using the same convention as the
+ * tracking wheels (angle is counter-clockwise positive and starts at 0). The tracking
+ * wheels provide the local translation of each step and a measurement of the angular
+ * velocity, while the IMU measures the angle and angular velocity directly.
+ * 
+ * All matrices are fixed size and each step is a handful of 4x4 operations, so no
+ * memory is allocated and the cost is in the order of microseconds.
+*/
+class OdomEKF {
+    public:
+        /**
+         * Number of states in the filter
+        */
+        static const int STATES = 4;
+
+        /**
+         * Index of each state in the state vector and covariance matrix
+        */
+        enum STATE_INDEX {
+            X = 0,
+            Y = 1,
+            ANGLE = 2,
+            ANGULAR_VELOCITY = 3
+        };
+
+        /**
+         * Initializes the OdomEKF class. Think of the Q values as how much the model is
+         * trusted (higher means less), and R values as how noisy each sensor is.
+         * @param iQDistance Position process noise variance per unit of distance travelled
+         * @param iQAngle Angle process noise variance per second
+         * @param iQAngularVelocity Angular velocity process noise variance per second (how quickly it can change)
+         * @param iRWheelRate Variance of the angular velocity measured by the tracking wheels (rad/s)^2
+         * @param iRImuAngle Variance of the IMU angle (rad^2)
+         * @param iRImuRate Variance of the IMU angular velocity (rad/s)^2
+        */
+        explicit OdomEKF(
+            double iQDistance = 0.0001,
+            double iQAngle = 0.00001,
+            double iQAngularVelocity = 50,
+            double iRWheelRate = 0.01,
+            double iRImuAngle = 0.0001,
+            double iRImuRate = 0.0025
+        );
+
+        /**
+         * Run a step of the filter with new sensor data
+         * @param localPos Translation since the last step in the robot's frame, as calculated from the tracking wheels
+         * @param wheelAngleDelta Change in angle since the last step measured by the tracking wheels (radians)
+         * @param imuAngle Angle measured by the IMU, counter-clockwise positive (radians)
+         * @param imuRate Angular velocity measured by the IMU, counter-clockwise positive (rad/s)
+         * @param dt Time since the last step in seconds
+        */
+        void filter(Vector2 localPos, double wheelAngleDelta, double imuAngle, double imuRate, double dt);
+
+        /**
+         * Reset the filter to a known pose with zero uncertainty
+         * @param x x value of the location
+         * @param y y value of the location
+         * @param angle The angle, counter-clockwise positive (radians)
+        */
+        void reset(double x, double y, double angle);
+
+        /**
+         * Returns the filtered position
+        */
+        Vector2 getPos() const { return Vector2(this->state[X], this->state[Y]); };
+
+        /**
+         * Returns the filtered angle, counter-clockwise positive (radians)
+        */
+        double getAngle() const { return this->state[ANGLE]; };
+
+        /**
+         * Returns the filtered angular velocity, counter-clockwise positive (rad/s)
+        */
+        double getAngularVelocity() const { return this->state[ANGULAR_VELOCITY]; };
+
+        /**
+         * Get an entry of the state covariance matrix
+         * @param row The row, as a STATE_INDEX
+         * @param col The column, as a STATE_INDEX
+        */
+        double getCovariance(int row, int col) const { return this->P[row][col]; };
+
+    protected:
+        /**
+         * Apply a measurement of a single state, where H is a unit row vector
+         * @param index The index of the state being measured
+         * @param measurement The measured value
+         * @param R The variance of the measurement
+        */
+        void update(int index, double measurement, double R);
+
+        const double QDistance, QAngle, QAngularVelocity;
+        const double RWheelRate, RImuAngle, RImuRate;
+
+        double state[STATES] = {0, 0, 0, 0};
+        double P[STATES][STATES] = {};
+};
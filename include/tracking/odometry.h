@@ -0,0 +1,209 @@
+/**
+ * \file odometry.h
+ * 
+ * \brief Contains the Odometry class, which holds the position tracking math used by the tracking task.
+ * 
+ * Doesn't depend on PROS, so the exact same math can be run off the robot (ex. to replay recorded sensor data).
+*/
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include "tracking.h"
+#include "tracking/odomEKF.h"
+
+/**
+ * \brief One reading of all the sensors used by odometry, as stored in recordings
+*/
+struct __attribute__((__packed__)) SensorSample {
+    /**
+     * Time of the reading in microseconds since the program started (wraps after ~71 minutes)
+    */
+    uint32_t timestamp;
+
+    /**
+     * Left tracking wheel encoder value in ticks
+    */
+    int32_t left;
+
+    /**
+     * Right tracking wheel encoder value in ticks
+    */
+    int32_t right;
+
+    /**
+     * Back tracking wheel encoder value in ticks
+    */
+    int32_t back;
+
+    /**
+     * IMU rotation in degrees, clockwise positive
+    */
+    float imuRotation;
+
+    /**
+     * IMU z axis gyro rate in degrees per second, clockwise positive
+    */
+    float imuRate;
+};
+
+/**
+ * \brief Dimensions of the robot that the odometry math depends on, in inches
+*/
+struct __attribute__((__packed__)) OdomGeometry {
+    /**
+     * Distance between the left and right tracking wheels
+    */
+    float wheelbase;
+
+    /**
+     * Distance of the back tracking wheel behind the center of the robot
+    */
+    float backWheelOffset;
+
+    /**
+     * Diameter of the tracking wheels
+    */
+    float trackingWheelDiameter;
+};
+
+/**
+ * Identifies a file as an odometry recording
+*/
+#define RECORDING_MAGIC "ODOM"
+
+/**
+ * Version of the recording format, increment when SensorSample or RecordingHeader change
+*/
+#define RECORDING_VERSION 1
+
+/**
+ * \brief Start of every odometry recording, followed by SensorSample entries until the end of the file
+*/
+struct __attribute__((__packed__)) RecordingHeader {
+    /**
+     * Always RECORDING_MAGIC, without the null terminator
+    */
+    char magic[4];
+
+    /**
+     * RECORDING_VERSION at the time of recording
+    */
+    uint16_t version;
+
+    /**
+     * Size of each SensorSample in bytes
+    */
+    uint16_t sampleSize;
+
+    /**
+     * Dimensions of the robot at the time of recording
+    */
+    OdomGeometry geometry;
+
+    /**
+     * Starting x value of the location
+    */
+    double startX;
+
+    /**
+     * Starting y value of the location
+    */
+    double startY;
+
+    /**
+     * Sensor reading at the start, which the first recorded sample is relative to
+    */
+    SensorSample start;
+};
+
+/**
+ * \brief Position tracking from tracking wheel encoders and the IMU
+*/
+class Odometry {
+    public:
+        /**
+         * Initializes the Odometry class
+         * @param geometry The dimensions of the robot
+        */
+        Odometry(OdomGeometry geometry);
+
+        /**
+         * Reset the tracking state to a known pose
+         * @param x x value of the location
+         * @param y y value of the location
+         * @param start Sensor reading at this pose, the next step is relative to it
+        */
+        void reset(double x, double y, const SensorSample& start);
+
+        /**
+         * Run a step of odometry with a new sensor reading
+         * @param sample The new sensor reading
+        */
+        void step(const SensorSample& sample);
+
+        /**
+         * Returns the current position
+        */
+        Vector2 getPos() const { return this->filter.getPos(); };
+
+        /**
+         * Returns the current heading in radians, using the same convention as TrackingData
+         * (clockwise from +y, the same as the IMU rotation)
+        */
+        double getHeading() const;
+
+        /**
+         * Returns the total distance travelled by the left tracking wheel in inches
+        */
+        double getLeftDistance() const { return this->left * this->degreeToInch(); };
+
+        /**
+         * Returns the total distance travelled by the right tracking wheel in inches
+        */
+        double getRightDistance() const { return this->right * this->degreeToInch(); };
+
+        /**
+         * Returns the total distance travelled laterally by the back tracking wheel in inches
+        */
+        double getLateralDistance() const { return this->lateral * this->degreeToInch(); };
+
+        /**
+         * Returns the filter fusing the tracking wheels with the IMU
+        */
+        const OdomEKF& getFilter() const { return this->filter; };
+
+    private:
+        /**
+         * Returns the distance travelled by a tracking wheel per encoder tick (degree) in inches
+        */
+        double degreeToInch() const { return M_PI * this->geometry.trackingWheelDiameter / 360; };
+
+        /**
+         * Dimensions of the robot
+        */
+        OdomGeometry geometry;
+
+        /**
+         * Fuses the tracking wheels with the IMU
+        */
+        OdomEKF filter;
+
+        // Previous encoder values in ticks
+        int32_t lLast = 0; // Last value of left tracking wheel
+        int32_t rLast = 0; // Last value of right tracking wheel
+        int32_t bLast = 0; // Last value of back tracking wheel
+
+        // Total distances in ticks, kept as integers so they never lose precision no matter
+        // how long the run is or how small each step is. Converted to inches only when used.
+        int64_t left = 0; // Total distance travelled by left tracking wheel
+        int64_t right = 0; // Total distance travelled by right tracking wheel
+        int64_t lateral = 0; // Total distance travelled laterally (measured from back tracking wheel)
+        double angle = 0; // Current arc angle
+
+        /**
+         * Time of the last step in microseconds
+        */
+        uint32_t lastTime = 0;
+};
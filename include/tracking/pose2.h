@@ -0,0 +1,198 @@
+/**
+ * \file pose2.h
+ * 
+ * \brief Contains the Rotation2 and Pose2 classes, which cache the sine and cosine of their angle.
+*/
+
+#pragma once
+
+#include <math.h>
+#include "fastTrig.h"
+#include "tracking/vector2.h"
+
+/**
+ * \brief Class object to represent a rotation in a 2 dimensional space
+ * 
+ * Stores the cosine and sine alongside the angle, so they're computed once when the
+ * rotation is created instead of on every use. Composing and inverting rotations
+ * uses the stored values and never calls any trig functions.
+*/
+class Rotation2 {
+    public:
+        /**
+         * Initializes the Rotation2 class with an angle of 0
+        */
+        constexpr Rotation2() : angle(0), cosA(1), sinA(0) {};
+
+        /**
+         * Initializes the Rotation2 class with an angle, computing its cosine and sine
+         * @param angle The angle in radians, counter-clockwise positive
+        */
+        Rotation2(double angle) : angle(angle) { Trig<CONTROL_TRIG_MODE>::sincos(angle, this->sinA, this->cosA); };
+
+        /**
+         * Initializes the Rotation2 class with an angle and its already known cosine and sine
+         * @param angle The angle in radians, counter-clockwise positive
+         * @param cosA Cosine of the angle
+         * @param sinA Sine of the angle
+        */
+        constexpr Rotation2(double angle, double cosA, double sinA) : angle(angle), cosA(cosA), sinA(sinA) {};
+
+        /**
+         * Returns the rotation from the robot's frame (+y forward, +x right) to the field's for a heading
+         * @param heading The heading in radians, clockwise from +y like TrackingData
+         * @param cosHeading Cosine of the heading
+         * @param sinHeading Sine of the heading
+        */
+        static constexpr Rotation2 fromHeading(double heading, double cosHeading, double sinHeading) {
+            // Headings are clockwise, rotations are counter-clockwise
+            return Rotation2(-heading, cosHeading, -sinHeading);
+        };
+
+        /**
+         * Returns the rotation from the robot's frame (+y forward, +x right) to the field's for a heading
+         * @param heading The heading in radians, clockwise from +y like TrackingData
+        */
+        static Rotation2 fromHeading(double heading) { return Rotation2(-heading); };
+
+        /**
+         * Returns the angle in radians
+        */
+        constexpr double getRadians() const { return this->angle; };
+
+        /**
+         * Returns the cosine of the angle
+        */
+        constexpr double getCos() const { return this->cosA; };
+
+        /**
+         * Returns the sine of the angle
+        */
+        constexpr double getSin() const { return this->sinA; };
+
+        /**
+         * Rotate a vector by this rotation
+         * @param vec The vector to rotate
+        */
+        constexpr Vector2 rotate(const Vector2& vec) const { return vec.rotate(this->cosA, this->sinA); };
+
+        /**
+         * Rotate a vector by the inverse of this rotation
+         * @param vec The vector to rotate
+        */
+        constexpr Vector2 unrotate(const Vector2& vec) const { return vec.rotate(this->cosA, -this->sinA); };
+
+        /**
+         * Returns the inverse of this rotation
+        */
+        constexpr Rotation2 inverse() const { return Rotation2(-this->angle, this->cosA, -this->sinA); };
+
+        /**
+         * Combine two rotations, using the angle sum identities
+        */
+        friend constexpr Rotation2 operator+(const Rotation2& r1, const Rotation2& r2) {
+            // cos(a + b) = cos(a)cos(b) - sin(a)sin(b), sin(a + b) = sin(a)cos(b) + cos(a)sin(b)
+            return Rotation2(
+                r1.angle + r2.angle,
+                (r1.cosA * r2.cosA) - (r1.sinA * r2.sinA),
+                (r1.sinA * r2.cosA) + (r1.cosA * r2.sinA)
+            );
+        };
+
+        /**
+         * Difference of two rotations
+        */
+        friend constexpr Rotation2 operator-(const Rotation2& r1, const Rotation2& r2) { return r1 + r2.inverse(); };
+
+    private:
+        /**
+         * The angle in radians
+        */
+        double angle;
+
+        /**
+         * Cosine of the angle
+        */
+        double cosA;
+
+        /**
+         * Sine of the angle
+        */
+        double sinA;
+};
+
+/**
+ * \brief Class object to represent a position and rotation in a 2 dimensional space
+*/
+class Pose2 {
+    public:
+        /**
+         * Initializes the Pose2 class at the origin with no rotation
+        */
+        constexpr Pose2() {};
+
+        /**
+         * Initializes the Pose2 class with a position and rotation
+         * @param translation The position
+         * @param rotation The rotation
+        */
+        constexpr Pose2(Vector2 translation, Rotation2 rotation) : translation(translation), rotation(rotation) {};
+
+        /**
+         * Returns the position
+        */
+        constexpr Vector2 getTranslation() const { return this->translation; };
+
+        /**
+         * Returns the rotation
+        */
+        constexpr Rotation2 getRotation() const { return this->rotation; };
+
+        /**
+         * Convert a point from the frame of this pose into the frame the pose is in
+         * @param point The point relative to this pose
+        */
+        constexpr Vector2 toGlobal(const Vector2& point) const { return this->translation + this->rotation.rotate(point); };
+
+        /**
+         * Convert a point into the frame of this pose
+         * @param point The point in the frame the pose is in
+        */
+        constexpr Vector2 toLocal(const Vector2& point) const { return this->rotation.unrotate(point - this->translation); };
+
+        /**
+         * Apply a pose relative to this one, ex. a movement in the robot's frame
+         * @param other The pose relative to this pose
+         * @return The combined pose
+        */
+        constexpr Pose2 transformBy(const Pose2& other) const {
+            return Pose2(this->toGlobal(other.translation), this->rotation + other.rotation);
+        };
+
+        /**
+         * Returns the inverse of this pose, so that pose.transformBy(pose.inverse()) is the origin
+        */
+        constexpr Pose2 inverse() const {
+            Rotation2 inverseRotation = this->rotation.inverse();
+            return Pose2(inverseRotation.rotate(-this->translation), inverseRotation);
+        };
+
+        /**
+         * Get this pose relative to another pose
+         * @param other The pose to use as the origin
+        */
+        constexpr Pose2 relativeTo(const Pose2& other) const {
+            return Pose2(other.toLocal(this->translation), this->rotation - other.rotation);
+        };
+
+    private:
+        /**
+         * The position
+        */
+        Vector2 translation;
+
+        /**
+         * The rotation
+        */
+        Rotation2 rotation;
+};
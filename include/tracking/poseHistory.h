@@ -0,0 +1,89 @@
+/**
+ * \file poseHistory.h
+ * 
+ * \brief Contains the PoseHistory class, a record of recent robot poses.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include "tracking.h"
+
+/**
+ * The number of poses kept in the history. At the default 10ms tracking
+ * period, 256 poses covers the last ~2.5s and takes 12KB.
+*/
+#ifndef POSE_HISTORY_LENGTH
+#define POSE_HISTORY_LENGTH 256
+#endif
+
+/**
+ * \brief Fixed-size ring buffer of timestamped poses, used to look up where the robot
+ * was when a delayed sensor reading (ex. vision) was captured.
+ * 
+ * Only one task may call push(), and it never blocks. Any task may call poseAt().
+*/
+class PoseHistory {
+    public:
+        /**
+         * Initializes the PoseHistory class with no poses
+        */
+        PoseHistory() {};
+
+        /**
+         * Add a pose to the history, overwriting the oldest one if full.
+         * Poses must be pushed in order of timestamp.
+         * @param pose The pose to add
+        */
+        void push(const PoseSnapshot& pose);
+
+        /**
+         * Get the pose of the robot at a specific time, interpolating between the
+         * two closest poses. Times newer than the latest pose return the latest pose.
+         * @param time The time to look up in microseconds since the program started
+         * @param pose Set to the pose at the time if found
+         * @return False if the history is empty or the time is older than the oldest pose
+        */
+        bool poseAt(uint64_t time, PoseSnapshot& pose) const;
+
+        /**
+         * Returns the number of poses currently stored
+        */
+        uint32_t size() const;
+
+        /**
+         * Remove all poses from the history, must be called from the pushing task
+        */
+        void clear();
+
+    private:
+        /**
+         * Get a stored pose by age, where 0 is the oldest
+         * @param index The index of the pose from the oldest one
+         * @param head The physical index of the oldest pose
+        */
+        const PoseSnapshot& at(uint32_t index, uint32_t head) const {
+            return this->poses[(head + index) % POSE_HISTORY_LENGTH];
+        }
+
+        /**
+         * Storage for the poses
+        */
+        PoseSnapshot poses[POSE_HISTORY_LENGTH];
+
+        /**
+         * Physical index of the oldest pose
+        */
+        uint32_t head = 0;
+
+        /**
+         * Number of poses stored
+        */
+        uint32_t count = 0;
+
+        /**
+         * Write sequence number, odd while a push is in progress (same scheme as SeqLock)
+        */
+        std::atomic<uint32_t> sequence{0};
+};
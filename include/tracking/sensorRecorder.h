@@ -0,0 +1,109 @@
+/**
+ * \file sensorRecorder.h
+ * 
+ * \brief Contains the SensorRecorder class, which records raw odometry sensor data to the SD card.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stdio.h>
+#include "main.h"
+#include "tracking/odometry.h"
+
+/**
+ * Number of samples in each recording buffer. At the default 10ms tracking period, each buffer
+ * holds 1.28s of data.
+*/
+#define RECORDER_BUFFER_SAMPLES 128
+
+/**
+ * \brief Records SensorSamples to a binary file, which can be replayed through the Odometry class
+ * off the robot with tools/odomReplay.cpp.
+ * 
+ * Samples are stored in one of two RAM buffers, and a separate task writes full buffers to the
+ * SD card, so record() never waits on the SD card. Only one task may call record().
+*/
+class SensorRecorder {
+    public:
+        /**
+         * Initializes the SensorRecorder class
+        */
+        SensorRecorder() {};
+
+        /**
+         * Open a new recording and start the task that writes it
+         * @param path The file to record to, ex. "/usd/odom.bin"
+         * @param header The header of the recording, magic, version and sample size are filled in automatically
+         * @return False if already recording or if the file could not be opened
+        */
+        bool start(const char* path, RecordingHeader header);
+
+        /**
+         * Add a sample to the recording, does nothing if not recording
+         * @param sample The sample to add
+        */
+        void record(const SensorSample& sample);
+
+        /**
+         * Write any remaining samples and close the recording
+        */
+        void stop();
+
+        /**
+         * Returns whether a recording is in progress
+        */
+        bool isRecording() { return this->recording; };
+
+        /**
+         * Returns the number of samples dropped because the SD card couldn't keep up
+        */
+        uint32_t getDropped() { return this->dropped; };
+
+    private:
+        /**
+         * Task that writes full buffers to the file
+         * @param param Pointer to the SensorRecorder
+        */
+        static void writer(void* param);
+
+        /**
+         * The sample buffers
+        */
+        SensorSample buffers[2][RECORDER_BUFFER_SAMPLES];
+
+        /**
+         * Index of the buffer being filled by record()
+        */
+        int activeBuffer = 0;
+
+        /**
+         * Number of samples in the active buffer
+        */
+        int activeCount = 0;
+
+        /**
+         * Index of the full buffer waiting to be written, -1 if none
+        */
+        std::atomic<int> pendingBuffer{-1};
+
+        /**
+         * Whether a recording is in progress
+        */
+        std::atomic<bool> recording{false};
+
+        /**
+         * Number of samples dropped
+        */
+        uint32_t dropped = 0;
+
+        /**
+         * The file being recorded to
+        */
+        FILE* file = NULL;
+
+        /**
+         * The task writing to the file
+        */
+        pros::Task* writerTask = NULL;
+};
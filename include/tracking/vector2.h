@@ -0,0 +1,174 @@
+/**
+ * \file vector2.h
+ * 
+ * \brief Contains the Vector2 class, a 2 dimensional vector.
+ * 
+ * Defined entirely in the header so the compiler can inline all of the vector math.
+*/
+
+#pragma once
+
+#include <math.h>
+#include "fastTrig.h"
+
+/**
+ * \brief Class object to represent a vector within a 2 dimensional space
+*/
+class Vector2 {
+    public:
+        /**
+         * Initializes the Vector2 class with preloaded x and y values
+         * @param x x value of the vector
+         * @param y y value of the vector
+        */
+        constexpr Vector2(double x, double y) : x(x), y(y) {};
+
+        /**
+         * Initializes the Vector2 class with default values (0, 0)
+        */
+        constexpr Vector2() : x(0), y(0) {};
+
+
+        /**
+         * Returns the x value of the vector
+        */
+        constexpr double getX() const { return this->x; };
+
+        /**
+         * Returns the y value of the vector
+        */
+        constexpr double getY() const { return this->y; };
+
+
+        /**
+         * Returns the squared magnitude of the vector, cheaper than getMagnitude() when comparing lengths
+        */
+        constexpr double lengthSquared() const { return (this->x * this->x) + (this->y * this->y); };
+
+        /**
+         * Returns the magnitude of the vector. Uses sqrt rather than hypot, which guards against
+         * overflow that field distances never reach and costs several times as much
+        */
+        double getMagnitude() const { return sqrt(this->lengthSquared()); };
+
+        /**
+         * Returns the angle of the vector
+        */
+        double getAngle() const { return Trig<CONTROL_TRIG_MODE>::atan2(this->y, this->x); };
+
+        /**
+         * Returns the heading that points along the vector, clockwise from +y like TrackingData
+        */
+        double getHeading() const { return Trig<CONTROL_TRIG_MODE>::atan2(this->x, this->y); };
+
+
+        /**
+         * Normalize the vector (change the length of the vector to 1 while retaining the direction)
+         * @return Normalized version of the vector, or (0, 0) if the vector has no length
+        */
+        Vector2 normalize() const {
+            double magnitude = this->getMagnitude();
+            if (magnitude == 0) {
+                return Vector2();
+            }
+
+            // Divide x and y by magnitude to retain direction
+            double inverse = 1.0 / magnitude;
+            return Vector2(this->x * inverse, this->y * inverse);
+        };
+
+        /**
+         * Dot product of two vectors
+         * @param other The other vector
+        */
+        constexpr double dot(const Vector2& other) const { return (this->x * other.x) + (this->y * other.y); };
+
+        /**
+         * Cross product of two vectors (z component of the 3D cross product)
+         * @param other The other vector
+        */
+        constexpr double cross(const Vector2& other) const { return (this->x * other.y) - (this->y * other.x); };
+
+        /**
+         * Rotate the vector counter-clockwise using a precomputed sine and cosine
+         * @param cosA Cosine of the angle to rotate by
+         * @param sinA Sine of the angle to rotate by
+         * @return Rotated version of the vector
+        */
+        constexpr Vector2 rotate(double cosA, double sinA) const {
+            return Vector2((this->x * cosA) - (this->y * sinA), (this->y * cosA) + (this->x * sinA));
+        };
+
+        /**
+         * Rotate the vector counter-clockwise
+         * @param angle The angle to rotate by in radians
+         * @return Rotated version of the vector
+        */
+        Vector2 rotate(double angle) const {
+            double s, c;
+            Trig<CONTROL_TRIG_MODE>::sincos(angle, s, c);
+            return this->rotate(c, s);
+        };
+
+        // Arithmetic functions
+
+        /**
+         * Simple vector addition
+        */
+        friend constexpr Vector2 operator+(const Vector2 &v1, const Vector2 &v2) { return Vector2(v1.x + v2.x, v1.y + v2.y); };
+        /**
+         * Simple vector subtraction
+        */
+        friend constexpr Vector2 operator-(const Vector2 &v1, const Vector2 &v2) { return Vector2(v1.x - v2.x, v1.y - v2.y); };
+        /**
+         * Vector negation
+        */
+        friend constexpr Vector2 operator-(const Vector2 &v) { return Vector2(-v.x, -v.y); };
+        /**
+         * Scalar and vector multiplication
+        */
+        friend constexpr Vector2 operator*(const Vector2 &v1, const double scalar) { return Vector2(v1.x * scalar, v1.y * scalar); };
+        /**
+         * Scalar and vector multiplication
+        */
+        friend constexpr Vector2 operator*(const double scalar, const Vector2 &v1) { return Vector2(v1.x * scalar, v1.y * scalar); };
+        /**
+         * Scalar and vector division
+        */
+        friend constexpr Vector2 operator/(const Vector2 &v1, const double scalar) { return Vector2(v1.x / scalar, v1.y / scalar); };
+        /**
+         * Exact equality of both components
+        */
+        friend constexpr bool operator==(const Vector2 &v1, const Vector2 &v2) { return v1.x == v2.x && v1.y == v2.y; };
+        /**
+         * Inequality of either component
+        */
+        friend constexpr bool operator!=(const Vector2 &v1, const Vector2 &v2) { return !(v1 == v2); };
+
+        /**
+         * Add a vector to this vector
+        */
+        constexpr Vector2& operator+=(const Vector2 &other) { this->x += other.x; this->y += other.y; return *this; };
+        /**
+         * Subtract a vector from this vector
+        */
+        constexpr Vector2& operator-=(const Vector2 &other) { this->x -= other.x; this->y -= other.y; return *this; };
+        /**
+         * Multiply this vector by a scalar
+        */
+        constexpr Vector2& operator*=(const double scalar) { this->x *= scalar; this->y *= scalar; return *this; };
+        /**
+         * Divide this vector by a scalar
+        */
+        constexpr Vector2& operator/=(const double scalar) { this->x /= scalar; this->y /= scalar; return *this; };
+    
+    private:
+        /**
+         * The x value of the vector
+        */
+        double x;
+        /**
+         * The y value of the vector
+        */
+        double y;
+};
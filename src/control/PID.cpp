@@ -3,7 +3,6 @@
 #include "main.h"
 
 #define DBL_MAX 1.7E308
-#define SETTLE_DELAY 2000
 
 PIDInfo::PIDInfo(double p, double i, double d) {
     // Set local variables to object vars
@@ -13,18 +12,43 @@ PIDInfo::PIDInfo(double p, double i, double d) {
 };
 
 
-PIDController::PIDController(double target, PIDInfo constants, double tolerance, double integralTolerance) {
+SettleCriteria::SettleCriteria(double errorBand, double velocityBand, double dwellTime, double timeout, double chainBand) {
+    // Set local variables to object vars
+    this->errorBand = errorBand;
+    this->velocityBand = velocityBand;
+    this->dwellTime = dwellTime;
+    this->timeout = timeout;
+    this->chainBand = chainBand;
+}
+
+
+PIDController::PIDController(double target, PIDInfo constants, double tolerance, double integralTolerance)
+    : PIDController(target, constants, SettleCriteria(tolerance), integralTolerance) {}
+
+PIDController::PIDController(double target, PIDInfo constants, SettleCriteria criteria, double integralTolerance) {
     // Set local variables to object vars
     this->target = target;
     this->lastError = DBL_MAX;
     this->constants = constants;
-    this->tolerance = tolerance;
+    this->criteria = criteria;
     this->integralTolerance = integralTolerance;
+    this->integral = 0;
+    this->derivative = 0;
 }
 
 double PIDController::step(double newSense) {
+    // Measure the time since the last step, the first step has nothing to measure from
+    uint64_t now = pros::micros();
+    double dt = this->lastTime == 0 ? 0 : (now - this->lastTime) / 1000000.0;
+    this->lastTime = now;
+
+    return this->step(newSense, dt);
+}
+
+double PIDController::step(double newSense, double dt) {
     // Set new sense
     this->sense = newSense;
+    this->elapsedTime += dt;
 
     // Get new error
     this->error = this->target - this->sense;
@@ -34,36 +58,43 @@ double PIDController::step(double newSense) {
         this->lastError = this->error;
     }
 
-    // Add integral to error since integral is sum of all errors
-    this->integral += this->error;
+    // Add integral to error since integral is sum of all errors over time
+    this->integral += this->error * dt;
 
-    // Get derivative (will be 0 on first iter since same)
-    this->derivative = this->error - this->lastError;
+    // Get derivative as rate of change of error (0 on first iter or if no time has passed)
+    this->derivative = dt > 0 ? (this->error - this->lastError) / dt : 0;
 
     // Set last error since we're done with last error calcs for now
     this->lastError = this->error;
 
     // Disable integral until it enters usuable range (surpasses threshold)
-    if (this->error == 0 || abs(this->error) > this->integralTolerance) {
+    if (this->error == 0 || fabs(this->error) > this->integralTolerance) {
         this->integral = 0;
     }
 
     // Run PID calculation with gains
     this->speed = (this->constants.p * this->error) + (this->constants.i * integral) + (this->constants.d * derivative);
 
-    // Start settling if error falls under tolerance
-    if (abs(this->error) <= this->tolerance) {
+    // Stop driving once the error is within the band
+    bool inErrorBand = fabs(this->error) <= this->criteria.errorBand;
+    if (inErrorBand) {
+        this->speed = 0;
+    }
+
+    // Start settling if error and its rate of change fall within their bands
+    if (inErrorBand && fabs(this->derivative) <= this->criteria.velocityBand) {
         // Start timer if it wasn't already settling
         if (!this->settling) {
-            this->settleStart = pros::millis();
+            this->settleTime = 0;
+        } else {
+            this->settleTime += dt;
         }
         
         // Set variables
         this->settling = true;
-        this->speed = 0;
 
-        // Consider controller settled after SETTLE_DELAY
-        if (pros::millis() - this->settleStart > SETTLE_DELAY) {
+        // Consider controller settled after staying in the bands for the dwell time
+        if (this->settleTime >= this->criteria.dwellTime) {
             this->settled = true;
         }
     } else {
@@ -80,11 +111,17 @@ void PIDController::reset() {
     this->target = 0;
     this->speed = 0;
 
-    this->lastError = 0;
+    this->lastError = DBL_MAX;
     this->error = 0;
 
     this->integral = 0;
     this->derivative = 0;
+
+    this->lastTime = 0;
+    this->settleTime = 0;
+    this->elapsedTime = 0;
+    this->settling = false;
+    this->settled = false;
 }
 
 double PIDController::getError() {
@@ -93,4 +130,13 @@ double PIDController::getError() {
 
 bool PIDController::isSettled() {
     return this->settled;
+}
+
+bool PIDController::isTimedOut() {
+    return this->criteria.timeout > 0 && this->elapsedTime >= this->criteria.timeout;
+}
+
+bool PIDController::isCloseEnough() {
+    // Needs at least one step so the error is real
+    return this->lastError != DBL_MAX && fabs(this->error) <= this->criteria.chainBand;
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "control/motionProfile.h"
+#include <math.h>
+
+void MotionProfile::build(double distance, ProfileConstraints constraints) {
+    this->distance = distance;
+    this->direction = distance < 0 ? -1 : 1;
+
+    double length = fabs(distance);
+    double maxVelocity = fabs(constraints.maxVelocity);
+    double maxAcceleration = fabs(constraints.maxAcceleration);
+    this->jerk = constraints.maxJerk > 0 ? constraints.maxJerk : INFINITY;
+
+    // Find the peak velocity, lowering it for motions too short to reach the maximum. The
+    // acceleration and deceleration phases together cover peakVelocity * accelTime.
+    double rampTime = isinf(this->jerk) ? maxVelocity / maxAcceleration
+        : (maxVelocity * this->jerk >= maxAcceleration * maxAcceleration
+            ? maxAcceleration / this->jerk + maxVelocity / maxAcceleration
+            : 2 * sqrt(maxVelocity / this->jerk));
+
+    if (maxVelocity * rampTime <= length) {
+        this->peakVelocity = maxVelocity;
+        this->cruiseTime = (length - maxVelocity * rampTime) / maxVelocity;
+    } else if (isinf(this->jerk)) {
+        // Triangular: v^2 / a = length
+        this->peakVelocity = sqrt(length * maxAcceleration);
+        this->cruiseTime = 0;
+    } else {
+        // Reaches the maximum acceleration: v^2 / a + v * a / j = length
+        double rampRatio = maxAcceleration / this->jerk;
+        this->peakVelocity = maxAcceleration / 2 * (sqrt(rampRatio * rampRatio + 4 * length / maxAcceleration) - rampRatio);
+
+        // Doesn't reach it, so acceleration only ramps up and down: 2 * v^1.5 / sqrt(j) = length
+        if (this->peakVelocity * this->jerk < maxAcceleration * maxAcceleration) {
+            this->peakVelocity = pow(length * sqrt(this->jerk) / 2, 2.0 / 3.0);
+        }
+        this->cruiseTime = 0;
+    }
+
+    // Timing of the acceleration phase for the peak velocity
+    if (isinf(this->jerk)) {
+        this->jerkTime = 0;
+        this->peakAcceleration = maxAcceleration;
+        this->accelTime = this->peakVelocity / maxAcceleration;
+    } else if (this->peakVelocity * this->jerk >= maxAcceleration * maxAcceleration) {
+        this->jerkTime = maxAcceleration / this->jerk;
+        this->peakAcceleration = maxAcceleration;
+        this->accelTime = this->jerkTime + this->peakVelocity / maxAcceleration;
+    } else {
+        this->jerkTime = sqrt(this->peakVelocity / this->jerk);
+        this->peakAcceleration = this->jerk * this->jerkTime;
+        this->accelTime = 2 * this->jerkTime;
+    }
+    this->duration = (2 * this->accelTime) + this->cruiseTime;
+
+    // Sample at the control loop period, or less often if the motion is too long for the table
+    this->samplePeriod = fmax(PROFILE_SAMPLE_PERIOD, this->duration / (PROFILE_TABLE_SIZE - 1));
+    this->samples = (int) ceil(this->duration / this->samplePeriod) + 1;
+    if (this->samples > PROFILE_TABLE_SIZE) {
+        this->samples = PROFILE_TABLE_SIZE;
+        this->samplePeriod = this->duration / (PROFILE_TABLE_SIZE - 1);
+    }
+    this->sampleRate = 1 / this->samplePeriod;
+
+    for (int i = 0; i < this->samples; i++) {
+        ProfileState state = this->evaluate(i * this->samplePeriod);
+        this->table[i].position = state.position;
+        this->table[i].velocity = state.velocity;
+        this->table[i].acceleration = state.acceleration;
+    }
+}
+
+ProfileState MotionProfile::sample(double t) const {
+    ProfileState state;
+    double index = t * this->sampleRate;
+
+    if (index <= 0) {
+        return state;
+    } else if (index >= this->samples - 1) {
+        // At rest on the target
+        state.position = this->distance;
+        return state;
+    }
+
+    // Interpolate between the samples either side, using their velocities to follow the curve of the position
+    int i = (int) index;
+    double f = index - i;
+    const Sample& a = this->table[i];
+    const Sample& b = this->table[i + 1];
+    double f2 = f * f, f3 = f2 * f;
+    state.position = (2 * f3 - 3 * f2 + 1) * a.position + (f3 - 2 * f2 + f) * this->samplePeriod * a.velocity
+                   + (3 * f2 - 2 * f3) * b.position + (f3 - f2) * this->samplePeriod * b.velocity;
+    state.velocity = a.velocity + (b.velocity - a.velocity) * f;
+    state.acceleration = a.acceleration + (b.acceleration - a.acceleration) * f;
+    return state;
+}
+
+ProfileState MotionProfile::evaluate(double t) const {
+    ProfileState state;
+
+    if (t <= 0) {
+        return state;
+    } else if (t < this->accelTime) {
+        state = this->accelerating(t);
+    } else if (t < this->accelTime + this->cruiseTime) {
+        // Cruising, the acceleration phase covers half of peakVelocity * accelTime
+        state.position = (this->peakVelocity * this->accelTime / 2) + this->peakVelocity * (t - this->accelTime);
+        state.velocity = this->peakVelocity;
+    } else if (t < this->duration) {
+        // Decelerating mirrors accelerating, measured backwards from the end
+        ProfileState mirrored = this->accelerating(this->duration - t);
+        state.position = fabs(this->distance) - mirrored.position;
+        state.velocity = mirrored.velocity;
+        state.acceleration = -mirrored.acceleration;
+    } else {
+        state.position = fabs(this->distance);
+    }
+
+    // Flip everything for motions in the negative direction
+    state.position *= this->direction;
+    state.velocity *= this->direction;
+    state.acceleration *= this->direction;
+    return state;
+}
+
+ProfileState MotionProfile::accelerating(double t) const {
+    ProfileState state;
+    double a = this->peakAcceleration;
+    double tj = this->jerkTime;
+
+    // State at the end of the jerk up, written with a / tj in place of the jerk so a trapezoid (tj = 0) works too
+    double v1 = a * tj / 2;
+    double p1 = a * tj * tj / 6;
+
+    if (t < tj) {
+        // Acceleration ramping up
+        state.acceleration = a * t / tj;
+        state.velocity = a * t * t / (2 * tj);
+        state.position = a * t * t * t / (6 * tj);
+    } else if (t < this->accelTime - tj) {
+        // Constant acceleration
+        double u = t - tj;
+        state.acceleration = a;
+        state.velocity = v1 + a * u;
+        state.position = p1 + v1 * u + a * u * u / 2;
+    } else {
+        // Acceleration ramping down, measured backwards from reaching the peak velocity
+        double w = this->accelTime - t;
+        double v = this->peakVelocity;
+        state.acceleration = tj > 0 ? a * w / tj : a;
+        state.velocity = v - (tj > 0 ? a * w * w / (2 * tj) : 0);
+        state.position = (v * this->accelTime / 2) - (v * w - (tj > 0 ? a * w * w * w / (6 * tj) : 0));
+    }
+
+    return state;
+}
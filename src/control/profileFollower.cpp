@@ -0,0 +1,58 @@
+#include "control/profileFollower.h"
+#include <math.h>
+
+ProfileFollower::ProfileFollower(Feedforward feedforward, PIDInfo constants, SettleCriteria criteria, double maxOutput)
+    : feedforward(feedforward), controller(constants), criteria(criteria), maxOutput(maxOutput) {}
+
+void ProfileFollower::start(const MotionProfile& profile, double startPosition) {
+    this->profile = &profile;
+    this->startPosition = startPosition;
+    this->controller.reset();
+
+    this->time = 0;
+    this->error = profile.getDistance();
+    this->lastError = this->error;
+    this->settleTime = 0;
+    this->settled = false;
+}
+
+double ProfileFollower::step(double sense, double dt) {
+    if (this->profile == nullptr) {
+        return 0;
+    }
+
+    // Sample the profile at the time this output will be applied
+    this->time += dt;
+    ProfileState state = this->profile->sample(this->time);
+
+    // Feedforward produces the profiled motion, PID only corrects the difference
+    this->controller.target = this->startPosition + state.position;
+    double output = this->feedforward.calculate(state.velocity, state.acceleration) + this->controller.step(sense, dt);
+    output = output > this->maxOutput ? this->maxOutput : (output < -this->maxOutput ? -this->maxOutput : output);
+
+    // Settling only starts once the profile has ended, as the target is still moving before then
+    this->error = this->startPosition + this->profile->getDistance() - sense;
+    double velocity = dt > 0 ? (this->error - this->lastError) / dt : 0;
+    this->lastError = this->error;
+
+    bool ended = this->time >= this->profile->getDuration();
+    if (ended && fabs(this->error) <= this->criteria.errorBand && fabs(velocity) <= this->criteria.velocityBand) {
+        this->settleTime += dt;
+        this->settled = this->settleTime >= this->criteria.dwellTime;
+    } else {
+        this->settleTime = 0;
+        this->settled = false;
+    }
+
+    return output;
+}
+
+bool ProfileFollower::isDone() const {
+    if (this->profile == nullptr) {
+        return true;
+    }
+
+    // Timeouts count from the end of the profile, so long motions aren't cut short
+    bool timedOut = this->criteria.timeout > 0 && this->time >= this->profile->getDuration() + this->criteria.timeout;
+    return this->settled || timedOut;
+}
@@ -0,0 +1,116 @@
+#include "control/purePursuit.h"
+#include <math.h>
+
+PurePursuit::PurePursuit(const Vector2* path, int count, PursuitSettings settings) {
+    // Set local variables to object vars
+    this->path = path;
+    this->count = count;
+    this->settings = settings;
+
+    // Precompute distances along the path so the remaining distance is a lookup
+    this->arcLength.resize(count > 0 ? count : 0);
+    double length = 0;
+    for (int i = 0; i < count; i++) {
+        if (i > 0) {
+            length += (path[i] - path[i - 1]).getMagnitude();
+        }
+        this->arcLength[i] = length;
+    }
+}
+
+void PurePursuit::reset() {
+    this->nearestIndex = 0;
+    this->lookaheadIndex = 0;
+}
+
+PursuitTarget PurePursuit::step(Vector2 position, double heading, double speed) {
+    PursuitTarget target;
+    if (this->count == 0) {
+        target.done = true;
+        return target;
+    }
+
+    // Walk forward from the last nearest point while the next point is closer
+    double nearestDistance = (this->path[this->nearestIndex] - position).lengthSquared();
+    while (this->nearestIndex + 1 < this->count) {
+        double next = (this->path[this->nearestIndex + 1] - position).lengthSquared();
+        if (next > nearestDistance) {
+            break;
+        }
+        nearestDistance = next;
+        this->nearestIndex++;
+    }
+
+    // Look further ahead when moving faster
+    double lookahead = this->settings.minLookahead + this->settings.lookaheadGain * fabs(speed);
+    lookahead = fmin(fmax(lookahead, this->settings.minLookahead), this->settings.maxLookahead);
+    double lookaheadSquared = lookahead * lookahead;
+
+    // Walk forward from the last lookahead segment to the first point outside the lookahead circle
+    if (this->lookaheadIndex < this->nearestIndex) {
+        this->lookaheadIndex = this->nearestIndex;
+    }
+    while (this->lookaheadIndex + 1 < this->count && (this->path[this->lookaheadIndex + 1] - position).lengthSquared() < lookaheadSquared) {
+        this->lookaheadIndex++;
+    }
+
+    if (this->lookaheadIndex + 1 < this->count) {
+        // Intersect the segment leaving the circle with the circle: |start + t * d - position| = lookahead
+        Vector2 start = this->path[this->lookaheadIndex];
+        Vector2 d = this->path[this->lookaheadIndex + 1] - start;
+        Vector2 f = start - position;
+
+        double a = d.lengthSquared();
+        double b = 2 * f.dot(d);
+        double c = f.lengthSquared() - lookaheadSquared;
+        double discriminant = b * b - 4 * a * c;
+
+        double t = 1;
+        if (a > 0 && discriminant >= 0) {
+            t = fmin(fmax((-b + sqrt(discriminant)) / (2 * a), 0), 1);
+        }
+        target.lookahead = start + d * t;
+    } else {
+        // The end of the path is inside the circle, so steer straight at it
+        target.lookahead = this->path[this->count - 1];
+    }
+
+    // Lateral offset of the lookahead point to the robot's right
+    Vector2 offset = target.lookahead - position;
+    double lateral = Rotation2::fromHeading(heading).unrotate(offset).getX();
+    double distanceSquared = offset.lengthSquared();
+    target.curvature = distanceSquared > 0 ? 2 * lateral / distanceSquared : 0;
+
+    // Remaining distance along the path, plus the gap to the nearest point
+    target.nearestIndex = this->nearestIndex;
+    target.remaining = this->getLength() - this->arcLength[this->nearestIndex];
+    if (this->nearestIndex == this->count - 1) {
+        target.remaining = sqrt(nearestDistance);
+    }
+    target.done = this->nearestIndex == this->count - 1 && (target.remaining <= this->settings.endTolerance || this->pastEnd(position));
+
+    return target;
+}
+
+bool PurePursuit::pastEnd(Vector2 position) const {
+    if (this->count < 2) {
+        return false;
+    }
+
+    // Past the end once the robot is ahead of the line through the last point, across the last segment
+    Vector2 end = this->path[this->count - 1];
+    return (position - end).dot(end - this->path[this->count - 2]) > 0;
+}
+
+double PurePursuit::getSpeed(const PursuitTarget& target) const {
+    if (target.done) {
+        return 0;
+    }
+
+    // Slow down linearly over the slowdown distance, but keep enough speed to reach the end
+    double speed = this->settings.maxSpeed;
+    if (target.remaining < this->settings.slowdownDistance && this->settings.slowdownDistance > 0) {
+        speed *= target.remaining / this->settings.slowdownDistance;
+    }
+    return fmax(speed, this->settings.minSpeed);
+}
@@ -0,0 +1,29 @@
+#include "control/ramsete.h"
+#include <math.h>
+
+WheelVelocities RamseteTracker::step(const Trajectory& trajectory, double t, Vector2 position, double heading) {
+    TrajectoryState reference = trajectory.sample(t);
+
+    // Error in the robot's frame, forward and to the left, with counter-clockwise angles as the
+    // control law is usually written
+    Vector2 offset = Rotation2::fromHeading(heading).unrotate(reference.position - position);
+    double forwardError = offset.getY();
+    double leftError = -offset.getX();
+    double headingError = -remainder(reference.heading - heading, 2 * M_PI);
+
+    double velocity = reference.velocity;
+    double angularVelocity = -reference.angularVelocity;
+
+    // sin(x) / x, which tends to 1 for small x
+    double sinc = fabs(headingError) < 1e-6 ? 1 : sin(headingError) / headingError;
+    double k = 2 * this->zeta * sqrt(angularVelocity * angularVelocity + this->b * velocity * velocity);
+
+    double v = velocity * cos(headingError) + k * forwardError;
+    double w = angularVelocity + k * headingError + this->b * velocity * sinc * leftError;
+
+    // Back to clockwise, where turning clockwise speeds up the left side
+    WheelVelocities wheels;
+    wheels.left = v - w * this->trackWidth / 2;
+    wheels.right = v + w * this->trackWidth / 2;
+    return wheels;
+}
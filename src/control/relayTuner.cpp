@@ -0,0 +1,135 @@
+#include "control/relayTuner.h"
+#include <math.h>
+#include <stdio.h>
+
+RelayTuner::RelayTuner(double setpoint, double amplitude, double hysteresis, int cycles) {
+    // Set local variables to object vars
+    this->setpoint = setpoint;
+    this->amplitude = fabs(amplitude);
+    this->hysteresis = fabs(hysteresis);
+    this->cycles = cycles;
+
+    this->output = this->amplitude;
+    this->peak = -INFINITY;
+    this->trough = INFINITY;
+}
+
+double RelayTuner::step(double sense, double dt) {
+    if (this->isDone()) {
+        return 0;
+    }
+
+    this->time += dt;
+
+    // Track the extremes of the current cycle
+    this->peak = fmax(this->peak, sense);
+    this->trough = fmin(this->trough, sense);
+
+    // Switch the relay once the sensor crosses the setpoint by more than the hysteresis
+    bool switchDown = this->output > 0 && sense > this->setpoint + this->hysteresis;
+    bool switchUp = this->output < 0 && sense < this->setpoint - this->hysteresis;
+    if (!switchDown && !switchUp) {
+        return this->output;
+    }
+
+    this->halfCycles++;
+    this->output = -this->output;
+
+    // A full cycle runs between switches to positive output and contains one peak and one trough.
+    // Cycles that start in the first half cycles are ignored while the system swings in from where it started.
+    if (switchUp) {
+        if (this->lastRiseTime >= 0) {
+            this->periodSum += this->time - this->lastRiseTime;
+            this->peakToPeakSum += this->peak - this->trough;
+            this->measuredCycles++;
+        }
+        if (this->halfCycles >= RELAY_SKIPPED_HALF_CYCLES) {
+            this->lastRiseTime = this->time;
+        }
+
+        // Start measuring the next cycle from this sensor value
+        this->peak = sense;
+        this->trough = sense;
+    }
+
+    return this->isDone() ? 0 : this->output;
+}
+
+double RelayTuner::getUltimateGain() const {
+    if (this->measuredCycles == 0) {
+        return 0;
+    }
+
+    // Describing function of a relay: the oscillation amplitude is half the peak to peak height
+    double oscillation = this->peakToPeakSum / this->measuredCycles / 2;
+    return oscillation > 0 ? (4 * this->amplitude) / (M_PI * oscillation) : 0;
+}
+
+double RelayTuner::getUltimatePeriod() const {
+    return this->measuredCycles > 0 ? this->periodSum / this->measuredCycles : 0;
+}
+
+PIDInfo RelayTuner::getGains(TUNING_RULE rule) const {
+    double ku = this->getUltimateGain();
+    double tu = this->getUltimatePeriod();
+
+    // Proportional gain, integral time and derivative time as fractions of Ku and Tu
+    double kp, ti, td;
+    switch (rule) {
+        case SOME_OVERSHOOT:
+            kp = 0.33 * ku;
+            ti = tu / 2;
+            td = tu / 3;
+            break;
+        case NO_OVERSHOOT:
+            kp = 0.2 * ku;
+            ti = tu / 2;
+            td = tu / 3;
+            break;
+        case ZIEGLER_NICHOLS:
+        default:
+            kp = 0.6 * ku;
+            ti = tu / 2;
+            td = tu / 8;
+            break;
+    }
+
+    // Convert to per second gains for PIDController
+    PIDInfo gains;
+    gains.p = kp;
+    gains.i = ti > 0 ? kp / ti : 0;
+    gains.d = kp * td;
+    return gains;
+}
+
+bool savePIDInfo(const char* path, PIDInfo gains) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        return false;
+    }
+
+    // Plain text so the gains can be read and edited by hand
+    int written = fprintf(file, "%.9g %.9g %.9g\n", gains.p, gains.i, gains.d);
+    fclose(file);
+    return written > 0;
+}
+
+bool loadPIDInfo(const char* path, PIDInfo& gains) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return false;
+    }
+
+    double p, i, d;
+    int read = fscanf(file, "%lf %lf %lf", &p, &i, &d);
+    fclose(file);
+
+    if (read != 3 || !isfinite(p) || !isfinite(i) || !isfinite(d)) {
+        return false;
+    }
+
+    gains.p = p;
+    gains.i = i;
+    gains.d = d;
+    return true;
+}
@@ -0,0 +1,211 @@
+#include "control/splinePath.h"
+#include <algorithm>
+#include <math.h>
+
+/**
+ * Unit vector pointing along a heading, clockwise from +y
+*/
+static Vector2 headingVector(double heading) {
+    return Vector2(sin(heading), cos(heading));
+}
+
+/**
+ * Curvature of a curve from its derivatives, positive turns clockwise
+*/
+static double curvatureOf(Vector2 velocity, Vector2 acceleration) {
+    double speed = velocity.getMagnitude();
+    if (speed < 1e-9) {
+        return 0;
+    }
+    return -velocity.cross(acceleration) / (speed * speed * speed);
+}
+
+SplinePath::SplinePath(const Waypoint* waypoints, int count, SPLINE_TYPE type, double tangentScale) {
+    if (count < 2) {
+        return;
+    }
+    int segmentCount = count - 1;
+
+    // Tangents leaving and entering each segment, scaled by its length so short segments don't loop
+    std::vector<Vector2> tangentStart(segmentCount), tangentEnd(segmentCount);
+    for (int i = 0; i < segmentCount; i++) {
+        double chord = (waypoints[i + 1].position - waypoints[i].position).getMagnitude();
+        tangentStart[i] = headingVector(waypoints[i].heading) * (chord * tangentScale);
+        tangentEnd[i] = headingVector(waypoints[i + 1].heading) * (chord * tangentScale);
+    }
+
+    // Curvature at each waypoint, estimated by averaging the cubic curves either side of it. The
+    // ends are straight so the robot starts and stops without turning
+    std::vector<double> curvature(count, 0);
+    if (type == SPLINE_QUINTIC_HERMITE) {
+        for (int i = 1; i < count - 1; i++) {
+            Vector2 before = waypoints[i].position - waypoints[i - 1].position;
+            Vector2 after = waypoints[i + 1].position - waypoints[i].position;
+            Vector2 accelBefore = (-6 * before) + (2 * tangentStart[i - 1]) + (4 * tangentEnd[i - 1]);
+            Vector2 accelAfter = (6 * after) - (4 * tangentStart[i]) - (2 * tangentEnd[i]);
+            curvature[i] = 0.5 * (curvatureOf(tangentEnd[i - 1], accelBefore) + curvatureOf(tangentStart[i], accelAfter));
+        }
+    }
+
+    this->segments.resize(segmentCount);
+    for (int i = 0; i < segmentCount; i++) {
+        Vector2 p0 = waypoints[i].position;
+        Vector2 p1 = waypoints[i + 1].position;
+        Vector2 v0 = tangentStart[i];
+        Vector2 v1 = tangentEnd[i];
+        Vector2 c[6];
+
+        if (type == SPLINE_CUBIC_BEZIER) {
+            // Control points p0, p0 + v0 / 3, p1 - v1 / 3 and p1, written as a polynomial
+            c[0] = p0;
+            c[1] = v0;
+            c[2] = (3 * (p1 - p0)) - (2 * v0) - v1;
+            c[3] = (2 * (p0 - p1)) + v0 + v1;
+        } else {
+            // Second derivatives normal to the path that give the waypoint curvatures at this segment's speed
+            Vector2 a0 = Vector2(cos(waypoints[i].heading), -sin(waypoints[i].heading)) * (curvature[i] * v0.lengthSquared());
+            Vector2 a1 = Vector2(cos(waypoints[i + 1].heading), -sin(waypoints[i + 1].heading)) * (curvature[i + 1] * v1.lengthSquared());
+            Vector2 d = p1 - p0;
+            c[0] = p0;
+            c[1] = v0;
+            c[2] = 0.5 * a0;
+            c[3] = (10 * d) - (6 * v0) - (4 * v1) - (1.5 * a0) + (0.5 * a1);
+            c[4] = (-15 * d) + (8 * v0) + (7 * v1) + (1.5 * a0) - a1;
+            c[5] = (6 * d) - (3 * v0) - (3 * v1) - (0.5 * a0) + (0.5 * a1);
+        }
+
+        for (int k = 0; k < 6; k++) {
+            this->segments[i].x[k] = c[k].getX();
+            this->segments[i].y[k] = c[k].getY();
+        }
+    }
+
+    // Integrate the length of each piece with 3 point Gauss-Legendre quadrature
+    const double nodes[3] = {-sqrt(0.6), 0, sqrt(0.6)};
+    const double weights[3] = {5.0 / 9, 8.0 / 9, 5.0 / 9};
+    double step = 1.0 / SPLINE_TABLE_RESOLUTION;
+    this->table.resize(segmentCount * SPLINE_TABLE_RESOLUTION + 1);
+
+    double distance = 0;
+    for (int i = 0; i < (int) this->table.size(); i++) {
+        double parameter = i * step;
+        if (i > 0) {
+            double middle = parameter - (0.5 * step);
+            double length = 0;
+            for (int k = 0; k < 3; k++) {
+                length += weights[k] * this->speed(middle + (0.5 * step * nodes[k]));
+            }
+            distance += 0.5 * step * length;
+        }
+
+        Vector2 position, velocity, acceleration;
+        this->evaluate(parameter, position, velocity, acceleration);
+        this->table[i].distance = distance;
+        this->table[i].parameter = parameter;
+        this->table[i].curvature = curvatureOf(velocity, acceleration);
+    }
+}
+
+void SplinePath::evaluate(double parameter, Vector2& position, Vector2& velocity, Vector2& acceleration) const {
+    // Split into segment and u, the end of the path belongs to the last segment
+    int index = std::min((int) parameter, (int) this->segments.size() - 1);
+    double u = parameter - index;
+    const Segment& s = this->segments[index];
+
+    // Horner's method for the polynomial and its derivatives
+    double x = s.x[5], y = s.y[5];
+    double dx = 5 * s.x[5], dy = 5 * s.y[5];
+    double ddx = 20 * s.x[5], ddy = 20 * s.y[5];
+    for (int k = 4; k >= 0; k--) {
+        x = (x * u) + s.x[k];
+        y = (y * u) + s.y[k];
+        if (k >= 1) {
+            dx = (dx * u) + (k * s.x[k]);
+            dy = (dy * u) + (k * s.y[k]);
+        }
+        if (k >= 2) {
+            ddx = (ddx * u) + (k * (k - 1) * s.x[k]);
+            ddy = (ddy * u) + (k * (k - 1) * s.y[k]);
+        }
+    }
+
+    position = Vector2(x, y);
+    velocity = Vector2(dx, dy);
+    acceleration = Vector2(ddx, ddy);
+}
+
+Vector2 SplinePath::getPosition(double parameter) const {
+    Vector2 position, velocity, acceleration;
+    if (!this->segments.empty()) {
+        this->evaluate(fmin(fmax(parameter, 0), this->segments.size()), position, velocity, acceleration);
+    }
+    return position;
+}
+
+double SplinePath::speed(double parameter) const {
+    Vector2 position, velocity, acceleration;
+    this->evaluate(parameter, position, velocity, acceleration);
+    return velocity.getMagnitude();
+}
+
+double SplinePath::parameterAt(double distance, double& curvature) const {
+    const TableEntry& first = this->table.front();
+    const TableEntry& last = this->table.back();
+    if (distance <= first.distance) {
+        curvature = first.curvature;
+        return first.parameter;
+    } else if (distance >= last.distance) {
+        curvature = last.curvature;
+        return last.parameter;
+    }
+
+    // First entry past the distance, so the distance lies between it and the one before
+    auto after = std::upper_bound(this->table.begin(), this->table.end(), distance,
+        [](double d, const TableEntry& entry) { return d < entry.distance; });
+    const TableEntry& a = *(after - 1);
+    const TableEntry& b = *after;
+
+    // Length is close to linear in the parameter over a piece this short
+    double f = (distance - a.distance) / (b.distance - a.distance);
+    curvature = a.curvature + (b.curvature - a.curvature) * f;
+    return a.parameter + (b.parameter - a.parameter) * f;
+}
+
+PathSample SplinePath::sample(double distance) const {
+    PathSample sample;
+    if (this->segments.empty()) {
+        return sample;
+    }
+
+    double parameter = this->parameterAt(distance, sample.curvature);
+    Vector2 velocity, acceleration;
+    this->evaluate(parameter, sample.position, velocity, acceleration);
+    sample.heading = atan2(velocity.getX(), velocity.getY());
+    sample.distance = fmin(fmax(distance, 0), this->getLength());
+    return sample;
+}
+
+std::vector<PathSample> SplinePath::sampleEvenly(double spacing) const {
+    std::vector<PathSample> samples;
+    if (this->segments.empty() || spacing <= 0) {
+        return samples;
+    }
+
+    double length = this->getLength();
+    int count = (int) ceil(length / spacing);
+    samples.reserve(count + 1);
+    for (int i = 0; i < count; i++) {
+        samples.push_back(this->sample(i * spacing));
+    }
+    samples.push_back(this->sample(length));
+    return samples;
+}
+
+std::vector<Vector2> SplinePath::getPoints(double spacing) const {
+    std::vector<PathSample> samples = this->sampleEvenly(spacing);
+    std::vector<Vector2> points(samples.size());
+    for (int i = 0; i < (int) samples.size(); i++) {
+        points[i] = samples[i].position;
+    }
+    return points;
+}
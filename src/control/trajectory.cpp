@@ -0,0 +1,90 @@
+#include "control/trajectory.h"
+#include <algorithm>
+#include <math.h>
+
+void Trajectory::plan(const std::vector<PathSample>& path, TrajectoryConstraints constraints) {
+    int count = (int) path.size();
+    this->states.resize(count);
+    if (count == 0) {
+        return;
+    }
+
+    // In a turn the outer wheel moves faster than the robot by a factor of (1 + |curvature| * trackWidth / 2),
+    // so cap the velocity and acceleration to keep it within the limits
+    auto wheelScale = [&](int i) { return 1 + fabs(path[i].curvature) * constraints.trackWidth / 2; };
+    for (int i = 0; i < count; i++) {
+        TrajectoryState& state = this->states[i];
+        state.position = path[i].position;
+        state.heading = path[i].heading;
+        state.curvature = path[i].curvature;
+        state.distance = path[i].distance;
+        state.velocity = constraints.maxVelocity / wheelScale(i);
+    }
+    this->states[0].velocity = fmin(this->states[0].velocity, constraints.startVelocity);
+    this->states[count - 1].velocity = fmin(this->states[count - 1].velocity, constraints.endVelocity);
+
+    // Forward pass, v^2 = u^2 + 2as limits how quickly the robot can speed up
+    for (int i = 1; i < count; i++) {
+        double ds = this->states[i].distance - this->states[i - 1].distance;
+        double acceleration = constraints.maxAcceleration / fmax(wheelScale(i - 1), wheelScale(i));
+        double reachable = sqrt(this->states[i - 1].velocity * this->states[i - 1].velocity + 2 * acceleration * ds);
+        this->states[i].velocity = fmin(this->states[i].velocity, reachable);
+    }
+
+    // Backward pass, the same limit for slowing down in time
+    for (int i = count - 2; i >= 0; i--) {
+        double ds = this->states[i + 1].distance - this->states[i].distance;
+        double acceleration = constraints.maxAcceleration / fmax(wheelScale(i), wheelScale(i + 1));
+        double reachable = sqrt(this->states[i + 1].velocity * this->states[i + 1].velocity + 2 * acceleration * ds);
+        this->states[i].velocity = fmin(this->states[i].velocity, reachable);
+    }
+
+    // Timestamps, assuming constant acceleration between samples
+    for (int i = 0; i < count; i++) {
+        TrajectoryState& state = this->states[i];
+        state.angularVelocity = state.velocity * state.curvature;
+
+        if (i + 1 < count) {
+            const TrajectoryState& next = this->states[i + 1];
+            double ds = next.distance - state.distance;
+            double vSum = state.velocity + next.velocity;
+            state.acceleration = ds > 0 ? (next.velocity * next.velocity - state.velocity * state.velocity) / (2 * ds) : 0;
+            this->states[i + 1].time = state.time + (vSum > 0 ? 2 * ds / vSum : 0);
+        } else {
+            state.acceleration = 0;
+        }
+    }
+}
+
+TrajectoryState Trajectory::sample(double t) const {
+    if (this->states.empty()) {
+        return TrajectoryState();
+    } else if (t <= 0) {
+        return this->states.front();
+    } else if (t >= this->getDuration()) {
+        return this->states.back();
+    }
+
+    // First sample after the time, so the time lies between it and the one before
+    auto after = std::upper_bound(this->states.begin(), this->states.end(), t,
+        [](double time, const TrajectoryState& state) { return time < state.time; });
+    const TrajectoryState& a = *(after - 1);
+    const TrajectoryState& b = *after;
+
+    // Move along with the acceleration between the samples
+    double dt = t - a.time;
+    double ds = b.distance - a.distance;
+    double travelled = a.velocity * dt + 0.5 * a.acceleration * dt * dt;
+    double f = ds > 0 ? fmin(fmax(travelled / ds, 0), 1) : 0;
+
+    TrajectoryState state;
+    state.position = a.position + (b.position - a.position) * f;
+    state.heading = a.heading + remainder(b.heading - a.heading, 2 * M_PI) * f;
+    state.curvature = a.curvature + (b.curvature - a.curvature) * f;
+    state.distance = a.distance + ds * f;
+    state.velocity = a.velocity + a.acceleration * dt;
+    state.angularVelocity = state.velocity * state.curvature;
+    state.acceleration = a.acceleration;
+    state.time = t;
+    return state;
+}
@@ -412,10 +412,24 @@ void DisplayController::setMode(DISPLAY_MODE mode) {
             sprintf(batteryString, "Battery: %2.0f%%", pros::battery::get_capacity());
             renderLabel(batteryString, 20, 10, scr);
 
+            // Tracking loop timing
+            LoopStats trackingStats = getTrackingStats();
+            char timingString[150];
+            sprintf(timingString, "Tracking period: %.2f ms (target %.2f ms)\nMin: %.2f ms, Max: %.2f ms\nJitter: %.2f ms, Overruns: %d",
+                trackingStats.meanPeriod / 1000.0,
+                trackingStats.targetPeriod / 1000.0,
+                trackingStats.minPeriod / 1000.0,
+                trackingStats.maxPeriod / 1000.0,
+                trackingStats.maxJitter / 1000.0,
+                (int) trackingStats.overruns
+            );
+            renderLabel(timingString, 20, 40, scr);
+
             /*
             // Tracking data
             char trackingString[100];
-            sprintf(trackingString, "X: %f\nY: %f\nA: %f\n", trackingData.getPos().getX(), trackingData.getPos().getY(), radToDeg(trackingData.getHeading()));
+            PoseSnapshot pose = trackingData.getSnapshot();
+            sprintf(trackingString, "X: %f\nY: %f\nA: %f\n", pose.x, pose.y, radToDeg(pose.heading));
             renderLabel(trackingString, 20, 60, scr);
         
             /*
@@ -2,6 +2,7 @@
 #include "driveSystems/SkidSteerDrive.h"
 #include "control/PID.h"
 #include "tracking.h"
+#include "chassis.h"
 
 SkidSteerDrive::SkidSteerDrive(pros::Motor *tLeft, pros::Motor *tRight, pros::Motor *bLeft, pros::Motor *bRight) {
     this->tLeft = tLeft;
@@ -34,8 +35,8 @@ void SkidSteerDrive::stop() {
 
 void SkidSteerDrive::tank(double leftSpeed, double rightSpeed, double threshold) {
     // Apply threshold
-    leftSpeed = leftSpeed < threshold ? 0 : leftSpeed;
-    rightSpeed = rightSpeed < threshold ? 0 : rightSpeed;
+    leftSpeed = fabs(leftSpeed) < threshold ? 0 : leftSpeed;
+    rightSpeed = fabs(rightSpeed) < threshold ? 0 : rightSpeed;
 
     this->tLeft->move(leftSpeed);
     this->bLeft->move(leftSpeed);
@@ -46,12 +47,54 @@ void SkidSteerDrive::tank(double leftSpeed, double rightSpeed, double threshold)
 
 void SkidSteerDrive::arcade(double forwardSpeed, double yaw, double threshold) {
     // Apply threshold
-    forwardSpeed = forwardSpeed < threshold ? 0 : forwardSpeed;
-    yaw = forwardSpeed < threshold ? 0 : yaw;
+    forwardSpeed = fabs(forwardSpeed) < threshold ? 0 : forwardSpeed;
+    yaw = fabs(yaw) < threshold ? 0 : yaw;
 
     this->tLeft->move(forwardSpeed + yaw);
     this->bLeft->move(forwardSpeed + yaw);
     
     this->tRight->move(forwardSpeed - yaw);
     this->bRight->move(forwardSpeed - yaw);
+}
+
+void SkidSteerDrive::forwardVelocity(double velocity) {
+    this->tankVelocity(velocity, velocity);
+}
+
+void SkidSteerDrive::rotateVelocity(double velocity) {
+    this->tankVelocity(velocity, -velocity);
+}
+
+void SkidSteerDrive::tankVelocity(double leftVelocity, double rightVelocity) {
+    int32_t left = this->toMotorVelocity(leftVelocity);
+    int32_t right = this->toMotorVelocity(rightVelocity);
+
+    this->tLeft->move_velocity(left);
+    this->bLeft->move_velocity(left);
+
+    this->tRight->move_velocity(right);
+    this->bRight->move_velocity(right);
+}
+
+double SkidSteerDrive::getMaxVelocity() {
+    // Top speed of the motors' gearset in rpm
+    double rpm;
+    switch (this->tLeft->get_gearing()) {
+        case pros::E_MOTOR_GEARSET_36:
+            rpm = 100;
+            break;
+        case pros::E_MOTOR_GEARSET_06:
+            rpm = 600;
+            break;
+        default:
+            rpm = 200;
+            break;
+    }
+
+    return rpm / 60 * M_PI * DRIVE_WHEEL_DIAMETER;
+}
+
+int32_t SkidSteerDrive::toMotorVelocity(double velocity) {
+    // Wheel surface speed to wheel rotations per minute
+    return (int32_t) round(velocity / (M_PI * DRIVE_WHEEL_DIAMETER) * 60);
 }
\ No newline at end of file
@@ -2,23 +2,55 @@
 #include "control/PID.h"
 #include "tracking.h"
 #include "globals.h"
+#include "chassis.h"
 #include <math.h>
 
 // Flips radian angle
 #define flipAngle(a)  (a > 0) ? (-2 * M_PI + a) : (2 * M_PI + a) 
 
-DrivetrainPID::DrivetrainPID(Drivetrain* drivetrain, PIDInfo driveConstants, PIDInfo turnConstants, double tolerance, double integralTolerance) {
-    this->driveController = new PIDController(0, driveConstants, tolerance, integralTolerance);
-    this->turnController = new PIDController(0, turnConstants, tolerance, integralTolerance);
+DrivetrainPID::DrivetrainPID(Drivetrain* drivetrain, PIDInfo driveConstants, PIDInfo turnConstants, double tolerance, double integralTolerance)
+    : driveController(0, driveConstants, tolerance, integralTolerance),
+      turnController(0, turnConstants, tolerance, integralTolerance),
+      ramsete(WHEELBASE) {
     this->drivetrain = drivetrain;
 }
 
 DrivetrainPID::~DrivetrainPID() {
-    delete this->driveController;
-    delete this->turnController;
     delete this->drivetrain;
 }
 
+void DrivetrainPID::driveForward(double output) {
+    if (this->outputMode == OUTPUT_VELOCITY) {
+        // Scale so full output is a fraction of the top velocity, the motors close the inner loop
+        this->drivetrain->forwardVelocity(output / 127 * VELOCITY_MODE_MAX_FRACTION * this->drivetrain->getMaxVelocity());
+    } else {
+        this->drivetrain->forward(output);
+    }
+}
+
+void DrivetrainPID::driveRotate(double output) {
+    if (this->outputMode == OUTPUT_VELOCITY) {
+        this->drivetrain->rotateVelocity(output / 127 * VELOCITY_MODE_MAX_FRACTION * this->drivetrain->getMaxVelocity());
+    } else {
+        this->drivetrain->rotate(output);
+    }
+}
+
+void DrivetrainPID::driveArcade(double forward, double turn) {
+    // Keep the turn when scaling down so steering isn't lost at full speed
+    double scale = fabs(forward) + fabs(turn) > 127 ? (127 - fmin(fabs(turn), 127)) / fabs(forward) : 1;
+    this->driveTank(forward * scale + turn, forward * scale - turn);
+}
+
+void DrivetrainPID::driveTank(double left, double right) {
+    if (this->outputMode == OUTPUT_VELOCITY) {
+        double maxVelocity = VELOCITY_MODE_MAX_FRACTION * this->drivetrain->getMaxVelocity();
+        this->drivetrain->tankVelocity(left / 127 * maxVelocity, right / 127 * maxVelocity);
+    } else {
+        this->drivetrain->tank(left, right);
+    }
+}
+
 void DrivetrainPID::move(Vector2 dir, double turn) {
     dir = toLocalCoordinates(dir);
     double velX = dir.getX();
@@ -26,8 +58,8 @@ void DrivetrainPID::move(Vector2 dir, double turn) {
 
     // Scale to be between [-127, 127] if not
     double scalar = 1;
-    if ((abs(velX) + abs(velY) + abs(turn)) > 1) {
-        scalar = abs(velX) + abs(velY) + abs(turn);
+    if ((fabs(velX) + fabs(velY) + fabs(turn)) > 1) {
+        scalar = fabs(velX) + fabs(velY) + fabs(turn);
     }
 
     // Calculate distance using pythagorean theorem and motor velocity
@@ -35,56 +67,488 @@ void DrivetrainPID::move(Vector2 dir, double turn) {
     double motorVel = (distance - turn) / scalar * 127;
 
     // Set motor vel
-    drivetrain->forward(motorVel);
+    this->driveForward(motorVel);
 }
 
 void DrivetrainPID::moveToOrientation(Vector2 target, double angle) {
-    // Turn to angle and drive to position
-    this->moveToPoint(target);
+    this->moveToOrientationAsync(target, angle).wait();
+}
 
-    // Turn to desired angle
-    this->rotateTo(angle);
+MotionHandle DrivetrainPID::moveToOrientationAsync(Vector2 target, double angle) {
+    MotionCommand command;
+    command.type = MOTION_MOVE_TO_ORIENTATION;
+    command.target = target;
+    command.angle = angle;
+    return this->enqueue(command);
 }
 
-void DrivetrainPID::moveToPoint(Vector2 target) {
-    // Turn to angle of point first (important in nonholonomic)
-    this->rotateTo(target.getAngle());
+void DrivetrainPID::moveToPoint(Vector2 target, double exitRadius, double minSpeed) {
+    this->moveToPointAsync(target, exitRadius, minSpeed).wait();
+}
 
-    this->driveController->target = 0; // Set target to 0 as loop will use delta as sense
+MotionHandle DrivetrainPID::moveToPointAsync(Vector2 target, double exitRadius, double minSpeed) {
+    MotionCommand command;
+    command.type = MOTION_MOVE_TO_POINT;
+    command.target = target;
+    command.exitRadius = exitRadius;
+    command.minSpeed = minSpeed;
+    return this->enqueue(command);
+}
 
-    do {
-        Vector2 delta = target - trackingData.getPos();
+MotionHandle DrivetrainPID::moveThroughAsync(std::initializer_list<Vector2> waypoints, double exitRadius, double minSpeed) {
+    MotionHandle last;
+    int remaining = waypoints.size();
+    for (Vector2 waypoint : waypoints) {
+        remaining--;
 
-        // Flip positivity since we're using the delta as the sense
-        float vel = -(this->driveController->step(delta.getMagnitude()));
+        // Chain through every waypoint but the last, which is settled on
+        last = remaining > 0 ? this->moveToPointAsync(waypoint, exitRadius, minSpeed) : this->moveToPointAsync(waypoint);
+    }
+    return last;
+}
+
+void DrivetrainPID::rotateTo(double angle) {
+    this->rotateToAsync(angle).wait();
+}
 
-        // Rotate the vector to restore direction since it only points left or right as of now
-        Vector2 driveVec = rotateVector(Vector2(vel, 0), delta.getAngle());
+MotionHandle DrivetrainPID::rotateToAsync(double angle) {
+    MotionCommand command;
+    command.type = MOTION_ROTATE_TO;
+    command.angle = angle;
+    return this->enqueue(command);
+}
 
-        this->move(driveVec, 0);
+void DrivetrainPID::followPath(const Vector2* path, int count, PursuitSettings settings) {
+    this->followPathAsync(path, count, settings).wait();
+}
 
-        pros::delay(20);
-    } while (!this->driveController->isSettled());
+MotionHandle DrivetrainPID::followPathAsync(const Vector2* path, int count, PursuitSettings settings) {
+    MotionCommand command;
+    command.type = MOTION_FOLLOW_PATH;
+    command.path = path;
+    command.pathLength = count;
+    command.pursuit = settings;
+    return this->enqueue(command);
+}
+
+void DrivetrainPID::followTrajectory(const Trajectory& trajectory, TrajectoryTracker* tracker) {
+    this->followTrajectoryAsync(trajectory, tracker).wait();
+}
+
+MotionHandle DrivetrainPID::followTrajectoryAsync(const Trajectory& trajectory, TrajectoryTracker* tracker) {
+    MotionCommand command;
+    command.type = MOTION_FOLLOW_TRAJECTORY;
+    command.trajectory = &trajectory;
+    command.tracker = tracker;
+    return this->enqueue(command);
 }
 
 void DrivetrainPID::moveRelative(Vector2 offset, double aOffset) {
     // Get the desired absolute position & angle
-    Vector2 desiredPos = trackingData.getPos() + offset;
-    double desiredAngle = trackingData.getHeading() + aOffset;
+    PoseSnapshot pose = trackingData.getSnapshot();
+    Vector2 desiredPos = Vector2(pose.x, pose.y) + offset;
+    double desiredAngle = pose.heading + aOffset;
 
     // Move robot to desired position & angle
     this->moveToOrientation(desiredPos, desiredAngle);
 }
 
-void DrivetrainPID::rotateTo(double target) {
+void DrivetrainPID::cancelAll() {
+    this->queueMutex.take(TIMEOUT_MAX);
+    for (uint32_t i = this->queueHead; i != this->queueTail; i++) {
+        MotionState& state = this->motions[i % MOTION_QUEUE_LENGTH];
+        state.cancelledId = state.id.load();
+    }
+    this->queueMutex.give();
+}
+
+bool DrivetrainPID::isMoving() {
+    return this->queueHead != this->queueTail;
+}
+
+MotionHandle DrivetrainPID::acquire() {
+    MotionCommand command;
+    command.type = MOTION_EXTERNAL;
+    MotionHandle handle = this->enqueue(command);
+
+    // Wait for the motions ahead of it to finish
+    while (!handle.isRunning() && !handle.isDone()) {
+        pros::delay(MOTION_WAIT_PERIOD);
+    }
+    return handle;
+}
+
+MotionHandle DrivetrainPID::enqueue(const MotionCommand& command) {
+    // Wait for the motion task to make space
+    this->queueMutex.take(TIMEOUT_MAX);
+    while (this->queueTail - this->queueHead >= MOTION_QUEUE_LENGTH) {
+        this->queueMutex.give();
+        pros::delay(MOTION_WAIT_PERIOD);
+        this->queueMutex.take(TIMEOUT_MAX);
+    }
+
+    MotionState& state = this->motions[this->queueTail % MOTION_QUEUE_LENGTH];
+    uint32_t id = this->nextMotionId++;
+    state.command = command;
+    state.distance = 0;
+    state.progress = 0;
+    state.started = false;
+    state.released = false;
+    state.id = id; // Set before clearing done so old handles never see this motion as theirs
+    state.done = false;
+    this->queueTail++;
+
+    if (this->motionTask == NULL) {
+        this->motionTask = new pros::Task(runMotions, this, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "Motion");
+    }
+    this->queueMutex.give();
+
+    this->motionTask->notify();
+    return MotionHandle(&state, id);
+}
+
+void DrivetrainPID::runMotions(void* param) {
+    DrivetrainPID* self = (DrivetrainPID*) param;
+
+    while (true) {
+        // Sleep until a motion is queued
+        pros::Task::notify_take(true, TIMEOUT_MAX);
+
+        while (self->queueHead != self->queueTail) {
+            MotionState& state = self->motions[self->queueHead % MOTION_QUEUE_LENGTH];
+            self->activeMotion = &state;
+
+            bool chained = false;
+            const MotionCommand& command = state.command;
+            if (!state.isCancelled()) {
+                state.started = true;
+                switch (command.type) {
+                    case MOTION_MOVE_TO_POINT:
+                        self->runMoveToPoint(command.target, command.exitRadius, command.minSpeed);
+                        chained = command.exitRadius > 0 && !state.isCancelled();
+                        break;
+                    case MOTION_ROTATE_TO:
+                        self->runRotateTo(command.angle);
+                        break;
+                    case MOTION_MOVE_TO_ORIENTATION:
+                        // Turn to angle and drive to position, then turn to desired angle
+                        self->runMoveToPoint(command.target);
+                        self->runRotateTo(command.angle);
+                        break;
+                    case MOTION_FOLLOW_PATH:
+                        self->runFollowPath(command);
+                        break;
+                    case MOTION_FOLLOW_TRAJECTORY:
+                        self->runFollowTrajectory(command);
+                        break;
+                    case MOTION_EXTERNAL:
+                        // Stay out of the way until the code driving it hands the drivetrain back,
+                        // it stops on its own once cancelled
+                        while (!state.released) {
+                            pros::delay(MOTION_WAIT_PERIOD);
+                        }
+                        break;
+                }
+            }
+
+            // Keep moving into the next motion after a chained motion, unless there isn't one or
+            // it isn't run here
+            uint32_t next = self->queueHead + 1;
+            self->carryingSpeed = chained && next != self->queueTail &&
+                self->motions[next % MOTION_QUEUE_LENGTH].command.type != MOTION_EXTERNAL;
+            if (!self->carryingSpeed) {
+                self->drivetrain->stop();
+            }
+
+            self->activeMotion = nullptr;
+            state.progress = 1;
+            state.done = true;
+            self->queueHead++;
+        }
+    }
+}
+
+void DrivetrainPID::runMoveToPoint(Vector2 target, double exitRadius, double minSpeed) {
+    bool chaining = exitRadius > 0;
+
+    // Turn to face the point first (important in nonholonomic), unless already moving roughly towards it.
+    // Headings are clockwise from +y.
+    Vector2 startDelta = target - trackingData.getPos();
+    double targetHeading = startDelta.getHeading();
+    double headingError = remainder(targetHeading - trackingData.getHeading(), 2 * M_PI);
+    if (!this->carryingSpeed || fabs(headingError) > CHAIN_TURN_IN_PLACE_ANGLE) {
+        this->carryingSpeed = false;
+        this->runRotateTo(targetHeading);
+    }
+    if (this->motionCancelled()) {
+        return;
+    }
+
+    this->driveController.reset(); // Start timing and settling fresh for this motion
+    this->driveController.target = 0; // Set target to 0 as loop will use delta as sense
+
+    Vector2 lastPos = trackingData.getPos();
+    double startDistance = startDelta.getMagnitude();
+    double steerDistance = fmax(MOVE_TO_POINT_STEER_DISTANCE, this->driveController.getSettleCriteria().errorBand);
+    MotionState* motion = this->activeMotion;
+
+    while (true) {
+        PoseSnapshot pose = trackingData.getSnapshot();
+        Vector2 pos(pose.x, pose.y);
+        Vector2 delta = target - pos;
+        double distance = delta.getMagnitude();
+
+        // Report progress for handles waiting on this motion
+        if (motion != nullptr) {
+            motion->distance = motion->distance + (pos - lastPos).getMagnitude();
+            if (motion->command.type != MOTION_ROTATE_TO && startDistance > 0) {
+                motion->progress = fmax(0, fmin(1, 1 - distance / startDistance));
+            }
+        }
+        lastPos = pos;
+
+        // Hand off to the next motion while still moving once inside the exit radius
+        if (chaining && distance <= exitRadius) {
+            break;
+        }
+
+        // Flip positivity since we're using the delta as the sense
+        float vel = -(this->driveController.step(distance));
+
+        // Carry at least the minimum speed through to the next motion
+        if (chaining) {
+            vel = fmax(fabs(vel), minSpeed);
+        }
+
+        // Slow down while pointed away from the target, driving only the part of the speed along the heading
+        headingError = remainder(delta.getHeading() - pose.heading, 2 * M_PI);
+        double forward = fabs(vel) * cos(headingError);
+
+        // Steer back towards the target, backing up instead of turning around if it's behind, ex. after
+        // overshooting it. Close to the target the direction to it is mostly noise, so only settle distance.
+        double turn = 0;
+        if (distance > steerDistance) {
+            if (forward < 0) {
+                headingError = remainder(headingError + M_PI, 2 * M_PI);
+            }
+            turn = this->turnController.getConstants().p * headingError;
+        }
+        this->driveArcade(forward, turn);
+
+        pros::delay(20);
+
+        if (this->motionCancelled()) {
+            break;
+        }
+        if (chaining) {
+            // Give up on the timeout, or hand off once past the target if the exit circle was missed
+            if (this->driveController.isDone() || delta.dot(startDelta) < 0) {
+                break;
+            }
+        } else if (this->motionDone(this->driveController)) {
+            break;
+        }
+    }
+}
+
+void DrivetrainPID::runRotateTo(double target) {
+    if (this->motionCancelled()) {
+        return;
+    }
+
     // Turn the other way if it's more efficient
-    if (abs(target - trackingData.getHeading()) > degToRad(180)) {
+    if (fabs(target - trackingData.getHeading()) > degToRad(180)) {
         target = flipAngle(target);
     }
 
-    turnController->target = target;
+    turnController.reset(); // Start timing and settling fresh for this motion
+    turnController.target = target;
+
+    double startError = fabs(target - trackingData.getHeading());
+    MotionState* motion = this->activeMotion;
+
     do {
-        // Run PID step and move to angle
-        move(Vector2(), turnController->step(trackingData.getHeading()));
-    } while (!turnController->isSettled());
-}
\ No newline at end of file
+        double heading = trackingData.getHeading();
+
+        // Turns only count towards progress for rotateTo(), other motions measure progress by distance
+        if (motion != nullptr && motion->command.type == MOTION_ROTATE_TO && startError > 0) {
+            motion->progress = fmax(0, fmin(1, 1 - fabs(target - heading) / startError));
+        }
+
+        // Run PID step and turn in place, positive output turns clockwise like the heading
+        this->driveRotate(turnController.step(heading));
+
+        // Leave time for other tasks, this runs on its own task now
+        pros::delay(20);
+    } while (!this->motionDone(turnController) && !this->motionCancelled());
+}
+
+template <typename Sense, typename Drive>
+bool DrivetrainPID::runTuner(const MotionHandle& motion, RelayTuner& tuner, Sense sense, Drive drive) {
+    LoopTimer timer(20);
+    timer.start();
+
+    uint64_t start = pros::micros();
+    uint64_t last = start;
+    while (!tuner.isDone() && !motion.shouldStop() && pros::micros() - start < TUNING_TIMEOUT * 1000000ULL) {
+        uint64_t now = pros::micros();
+        drive(tuner.step(sense(), (now - last) / 1000000.0));
+        last = now;
+
+        timer.wait();
+    }
+
+    this->drivetrain->stop();
+    return tuner.isDone();
+}
+
+bool DrivetrainPID::tuneDrive(double distance, double amplitude, TUNING_RULE rule) {
+    // Drive the experiment directly, but through the motion queue so it waits for queued motions and can be cancelled
+    MotionHandle motion = this->acquire();
+
+    // Oscillate around a point ahead of the robot, measuring distance along its starting heading
+    Pose2 pose = trackingData.getPose();
+    Vector2 start = pose.getTranslation();
+    Vector2 forward = pose.getRotation().rotate(Vector2(0, 1));
+
+    RelayTuner tuner(distance, amplitude, 0.1);
+    bool done = this->runTuner(motion, tuner,
+        [&]() { return (trackingData.getPos() - start).dot(forward); },
+        [&](double output) { this->driveForward(output); });
+    motion.release();
+
+    if (!done) {
+        return false;
+    }
+
+    PIDInfo gains = tuner.getGains(rule);
+    this->driveController.setConstants(gains);
+    savePIDInfo(DRIVE_GAINS_PATH, gains);
+    return true;
+}
+
+bool DrivetrainPID::tuneTurn(double angle, double amplitude, TUNING_RULE rule) {
+    MotionHandle motion = this->acquire();
+
+    // Heading increases clockwise, same as the direction Drivetrain::rotate() turns with positive speed
+    RelayTuner tuner(trackingData.getHeading() + angle, amplitude, degToRad(0.5));
+    bool done = this->runTuner(motion, tuner,
+        [&]() { return trackingData.getHeading(); },
+        [&](double output) { this->driveRotate(output); });
+    motion.release();
+
+    if (!done) {
+        return false;
+    }
+
+    PIDInfo gains = tuner.getGains(rule);
+    this->turnController.setConstants(gains);
+    savePIDInfo(TURN_GAINS_PATH, gains);
+    return true;
+}
+
+void DrivetrainPID::loadGains() {
+    PIDInfo gains;
+    if (loadPIDInfo(DRIVE_GAINS_PATH, gains)) {
+        this->driveController.setConstants(gains);
+    }
+    if (loadPIDInfo(TURN_GAINS_PATH, gains)) {
+        this->turnController.setConstants(gains);
+    }
+}
+
+void DrivetrainPID::runFollowPath(const MotionCommand& command) {
+    PurePursuit pursuit(command.path, command.pathLength, command.pursuit);
+    MotionState* motion = this->activeMotion;
+    double length = pursuit.getLength();
+
+    PoseSnapshot last = trackingData.getSnapshot();
+    double speed = 0;
+    uint64_t start = pros::micros();
+    while (!this->motionCancelled()) {
+        // Give up once the timeout has passed, ex. if the robot is blocked
+        if (command.pursuit.timeout > 0 && pros::micros() - start >= command.pursuit.timeout * 1000000) {
+            break;
+        }
+
+        PoseSnapshot pose = trackingData.getSnapshot();
+        Vector2 pos(pose.x, pose.y);
+
+        // Measure speed from the tracked position for the lookahead distance, once per tracking update
+        if (pose.timestamp != last.timestamp) {
+            double moved = (pos - Vector2(last.x, last.y)).getMagnitude();
+            speed = moved / ((pose.timestamp - last.timestamp) / 1000000.0);
+            if (motion != nullptr) {
+                motion->distance = motion->distance + moved;
+            }
+            last = pose;
+        }
+
+        PursuitTarget target = pursuit.step(pos, pose.heading, speed);
+
+        // Report progress for handles waiting on this motion
+        if (motion != nullptr) {
+            motion->progress = length > 0 ? fmax(0, fmin(1, 1 - target.remaining / length)) : 1;
+        }
+
+        if (target.done) {
+            break;
+        }
+
+        // Drive along the arc, the outside wheels go faster by the curvature times half the wheelbase
+        double vel = pursuit.getSpeed(target);
+        double left = vel * (1 + target.curvature * WHEELBASE / 2);
+        double right = vel * (1 - target.curvature * WHEELBASE / 2);
+
+        // Keep the ratio between the sides when either would saturate
+        double largest = fmax(fabs(left), fabs(right));
+        if (largest > 127) {
+            left *= 127 / largest;
+            right *= 127 / largest;
+        }
+        this->driveTank(left, right);
+
+        pros::delay(10);
+    }
+}
+
+void DrivetrainPID::runFollowTrajectory(const MotionCommand& command) {
+    const Trajectory& trajectory = *command.trajectory;
+    TrajectoryTracker* tracker = command.tracker != nullptr ? command.tracker : &this->ramsete;
+    MotionState* motion = this->activeMotion;
+    double duration = trajectory.getDuration();
+    tracker->reset();
+
+    PoseSnapshot last = trackingData.getSnapshot();
+    uint64_t start = pros::micros();
+    while (!this->motionCancelled()) {
+        // The trajectory is indexed by time since the motion started
+        double t = (pros::micros() - start) / 1000000.0;
+        if (t >= duration) {
+            break;
+        }
+
+        PoseSnapshot pose = trackingData.getSnapshot();
+        Vector2 pos(pose.x, pose.y);
+
+        // Report progress for handles waiting on this motion
+        if (motion != nullptr) {
+            motion->distance = motion->distance + (pos - Vector2(last.x, last.y)).getMagnitude();
+            motion->progress = duration > 0 ? t / duration : 1;
+        }
+        last = pose;
+
+        WheelVelocities wheels = tracker->step(trajectory, t, pos, pose.heading);
+
+        // Keep the ratio between the sides when either would be faster than the drive can go
+        double maxVelocity = this->drivetrain->getMaxVelocity();
+        double largest = fmax(fabs(wheels.left), fabs(wheels.right));
+        if (largest > maxVelocity) {
+            wheels.left *= maxVelocity / largest;
+            wheels.right *= maxVelocity / largest;
+        }
+        this->drivetrain->tankVelocity(wheels.left, wheels.right);
+
+        pros::delay(10);
+    }
+}
@@ -0,0 +1,65 @@
+#include "main.h"
+#include "driveSystems/motionHandle.h"
+
+bool MotionHandle::isDone() const {
+    if (this->state == nullptr) {
+        return true;
+    }
+
+    // Check the id after the flag, a reused slot means this motion finished long ago
+    bool done = this->state->done;
+    return done || this->state->id != this->id;
+}
+
+bool MotionHandle::isRunning() const {
+    return this->isCurrent() && this->state->started && !this->isDone();
+}
+
+bool MotionHandle::shouldStop() const {
+    return this->isDone() || this->state->cancelledId == this->id;
+}
+
+double MotionHandle::getDistance() const {
+    if (!this->isCurrent()) {
+        return 0;
+    }
+    return this->state->distance;
+}
+
+double MotionHandle::getProgress() const {
+    if (!this->isCurrent()) {
+        return 1;
+    }
+    return this->isDone() ? 1 : this->state->progress.load();
+}
+
+void MotionHandle::wait() const {
+    while (!this->isDone()) {
+        pros::delay(MOTION_WAIT_PERIOD);
+    }
+}
+
+void MotionHandle::waitUntilDistance(double distance) const {
+    while (!this->isDone() && this->getDistance() < distance) {
+        pros::delay(MOTION_WAIT_PERIOD);
+    }
+}
+
+void MotionHandle::waitUntilProgress(double progress) const {
+    while (!this->isDone() && this->getProgress() < progress) {
+        pros::delay(MOTION_WAIT_PERIOD);
+    }
+}
+
+void MotionHandle::cancel() {
+    // Compared against the id by the motion task, so this is harmless if the slot was reused in between
+    if (this->state != nullptr) {
+        this->state->cancelledId = this->id;
+    }
+}
+
+void MotionHandle::release() {
+    if (this->isCurrent()) {
+        this->state->released = true;
+    }
+}
@@ -0,0 +1,116 @@
+#include "driveSystems/profiledDrive.h"
+#include "loopTimer.h"
+#include "globals.h"
+#include <math.h>
+
+ProfiledDrive::ProfiledDrive(Drivetrain* drivetrain, DrivetrainPID* motions, ProfiledAxis drive, ProfiledAxis turn)
+    : drive(drive), turn(turn),
+      driveFollower(drive.feedforward, drive.constants, drive.criteria),
+      turnFollower(turn.feedforward, turn.constants, turn.criteria) {
+    this->drivetrain = drivetrain;
+    this->motions = motions;
+}
+
+template <typename Sense, typename Output>
+void ProfiledDrive::follow(ProfileFollower& follower, Sense sense, Output output) {
+    // Skip the rest of a motion once it has been cancelled
+    if (this->motion.shouldStop()) {
+        return;
+    }
+
+    LoopTimer timer(PROFILED_DRIVE_PERIOD);
+    timer.start();
+
+    uint64_t last = pros::micros();
+    do {
+        uint64_t now = pros::micros();
+        output(follower.step(sense(), (now - last) / 1000000.0));
+        last = now;
+
+        timer.wait();
+    } while (!follower.isDone() && !this->motion.shouldStop());
+
+    this->drivetrain->stop();
+}
+
+void ProfiledDrive::moveToPoint(Vector2 target) {
+    this->motion = this->motions->acquire();
+    this->runMoveToPoint(target);
+    this->motion.release();
+}
+
+void ProfiledDrive::runMoveToPoint(Vector2 target) {
+    // Turn to face the point first (important in nonholonomic), headings are clockwise from +y
+    Vector2 delta = target - trackingData.getPos();
+    if (delta.lengthSquared() > 0) {
+        this->runRotateTo(delta.getHeading());
+    }
+
+    // Drive the distance left once facing the point
+    this->driveProfile.build((target - trackingData.getPos()).getMagnitude(), this->drive.constraints);
+    this->runDriveProfile(this->driveProfile);
+}
+
+void ProfiledDrive::rotateTo(double angle) {
+    this->motion = this->motions->acquire();
+    this->runRotateTo(angle);
+    this->motion.release();
+}
+
+void ProfiledDrive::runRotateTo(double angle) {
+    // Turn the shortest way around
+    double start = trackingData.getHeading();
+    double delta = remainder(angle - start, 2 * M_PI);
+
+    this->turnProfile.build(delta, this->turn.constraints);
+    this->runTurnProfile(this->turnProfile);
+}
+
+void ProfiledDrive::followTurnProfile(const MotionProfile& profile) {
+    this->motion = this->motions->acquire();
+    this->runTurnProfile(profile);
+    this->motion.release();
+}
+
+void ProfiledDrive::runTurnProfile(const MotionProfile& profile) {
+    // Heading increases clockwise, same as the direction Drivetrain::rotate() turns with positive speed
+    this->turnFollower.start(profile, trackingData.getHeading());
+    this->follow(this->turnFollower,
+        [&]() { return trackingData.getHeading(); },
+        [&](double output) { this->drivetrain->rotate(output); });
+}
+
+void ProfiledDrive::moveToOrientation(Vector2 target, double angle) {
+    this->motion = this->motions->acquire();
+
+    // Turn to angle and drive to position
+    this->runMoveToPoint(target);
+
+    // Turn to desired angle
+    this->runRotateTo(angle);
+
+    this->motion.release();
+}
+
+void ProfiledDrive::driveDistance(double distance) {
+    this->driveProfile.build(distance, this->drive.constraints);
+    this->followDriveProfile(this->driveProfile);
+}
+
+void ProfiledDrive::followDriveProfile(const MotionProfile& profile) {
+    this->motion = this->motions->acquire();
+    this->runDriveProfile(profile);
+    this->motion.release();
+}
+
+void ProfiledDrive::runDriveProfile(const MotionProfile& profile) {
+    // Measure progress along the starting heading
+    Pose2 pose = trackingData.getPose();
+    Vector2 start = pose.getTranslation();
+    Vector2 forward = pose.getRotation().rotate(Vector2(0, 1));
+
+    this->driveFollower.start(profile, 0);
+    this->follow(this->driveFollower,
+        [&]() { return (trackingData.getPos() - start).dot(forward); },
+        [&](double output) { this->drivetrain->forward(output); });
+}
@@ -5,6 +5,17 @@
 PIDInfo driveConstants(1, 1, 1);
 PIDInfo turnConstants(1, 1, 1);
 
+// Profiled drive settings. The feedforward constants are placeholders worked out from the drivetrain model
+// in tools/driveSim.cpp (0.27 in/s per unit of power, 0.15s time constant) rather than measured, so kV is
+// 1 / 0.27 and kA is 0.15 / 0.27 for driving, and WHEELBASE / 2 times those for turning. The limits keep
+// kS + kV * v + kA * a under full power. Replace them with values fitted on the robot.
+ProfiledAxis profiledDriveAxis(ProfileConstraints(25, 40, 300), Feedforward(5, 3.7, 0.56), PIDInfo(8, 0, 0.5), SettleCriteria(0.5, 2, 0.1, 1));
+ProfiledAxis profiledTurnAxis(ProfileConstraints(4.5, 10, 60), Feedforward(5, 19, 2.85), PIDInfo(60, 0, 4), SettleCriteria(degToRad(1), degToRad(10), 0.1, 1));
+
 // Definitions
 SkidSteerDrive* driveTrain = new SkidSteerDrive(&tLeft, &tRight, &bLeft, &bRight);
-DrivetrainPID driveTrainPID(driveTrain, driveConstants, turnConstants, 1, 1);
\ No newline at end of file
+DrivetrainPID driveTrainPID(driveTrain, driveConstants, turnConstants, 1, 1);
+ProfiledDrive profiledDrive(driveTrain, &driveTrainPID, profiledDriveAxis, profiledTurnAxis);
+
+// Top wheel velocity of the 200 rpm (green) drive motors in inches per second
+MPCTracker<MPC_DEFAULT_HORIZON> mpcTracker(WHEELBASE, 200 * M_PI * DRIVE_WHEEL_DIAMETER / 60);
@@ -1,4 +1,5 @@
 #include "globals.h"
 #include "tracking.h"
 
-TrackingData trackingData(0, 0, 0);
\ No newline at end of file
+TrackingData trackingData(0, 0, 0);
+PoseHistory poseHistory;
\ No newline at end of file
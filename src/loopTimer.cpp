@@ -0,0 +1,65 @@
+#include "loopTimer.h"
+#include "main.h"
+
+LoopTimer::LoopTimer(uint32_t period) {
+    this->setPeriod(period);
+}
+
+void LoopTimer::setPeriod(uint32_t period) {
+    // Don't go below the minimum period, the scheduler can't hold it reliably
+    this->period = period < LOOP_TIMER_MIN_PERIOD ? LOOP_TIMER_MIN_PERIOD : period;
+}
+
+void LoopTimer::start() {
+    this->wakeTime = pros::millis();
+    this->iterationStart = pros::micros();
+    this->resetStats();
+}
+
+void LoopTimer::wait() {
+    // Check whether the work done this iteration took longer than a period
+    uint64_t workEnd = pros::micros();
+    uint32_t targetPeriod = this->period * 1000;
+    if (workEnd - this->iterationStart > targetPeriod) {
+        this->stats.overruns++;
+    }
+
+    // Sleep until the next period, relative to the last wake time so any work done doesn't cause drift
+    pros::Task::delay_until(&this->wakeTime, this->period);
+
+    // Measure the actual period from the start of this iteration to the start of the next
+    uint64_t now = pros::micros();
+    uint32_t measured = now - this->iterationStart;
+    uint32_t jitter = measured > targetPeriod ? measured - targetPeriod : targetPeriod - measured;
+    this->iterationStart = now;
+
+    // Update the statistics
+    this->periodSum += measured;
+    this->stats.iterations++;
+    this->stats.targetPeriod = targetPeriod;
+    this->stats.meanPeriod = this->periodSum / this->stats.iterations;
+
+    if (this->stats.iterations == 1 || measured < this->stats.minPeriod) {
+        this->stats.minPeriod = measured;
+    }
+    if (measured > this->stats.maxPeriod) {
+        this->stats.maxPeriod = measured;
+    }
+    if (jitter > this->stats.maxJitter) {
+        this->stats.maxJitter = jitter;
+    }
+
+    // Publish every field at once so a reader never mixes two iterations
+    this->publishedStats.write(this->stats);
+}
+
+LoopStats LoopTimer::getStats() {
+    return this->publishedStats.read();
+}
+
+void LoopTimer::resetStats() {
+    this->periodSum = 0;
+    this->stats = LoopStats();
+    this->stats.targetPeriod = this->period * 1000;
+    this->publishedStats.write(this->stats);
+}
@@ -18,6 +18,19 @@ void on_center_button() {
 	// }
 }
 
+/**
+ * Cancel any motions still running from autonomous, then stop the drivetrain once the motion
+ * task has let go of it. The motion task isn't tied to the competition mode, so without this a
+ * motion can keep driving into the next mode.
+ */
+static void stopMotions() {
+	driveTrainPID.cancelAll();
+	while (driveTrainPID.isMoving()) {
+		pros::delay(5);
+	}
+	driveTrain->stop();
+}
+
 /**
  * Runs initialization code. This occurs as soon as the program is started.
  *
@@ -30,6 +43,9 @@ void initialize() {
 
 	// pros::lcd::register_btn1_cb(on_center_button);
 
+	// Use gains saved by the tuner if there are any, otherwise keep the ones in src/globals/drivetrain.cpp
+	driveTrainPID.loadGains();
+
 	display.setMode(SELECTOR);
 }
 
@@ -38,7 +54,9 @@ void initialize() {
  * the VEX Competition Switch, following either autonomous or opcontrol. When
  * the robot is enabled, this task will exit.
  */
-void disabled() {}
+void disabled() {
+	stopMotions();
+}
 
 /**
  * Runs after initialize(), and before autonomous when connected to the Field
@@ -80,5 +98,6 @@ void autonomous() {
  * task, not resume it from where it left off.
  */
 void opcontrol() {
+	stopMotions();
 	myOpControl();
 }
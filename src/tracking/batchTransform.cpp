@@ -0,0 +1,88 @@
+#include "tracking/batchTransform.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define BATCH_TRANSFORM_NEON
+#endif
+
+void batchToLocalScalar(const float* x, const float* y, float* outX, float* outY, int count, const Pose2& pose) {
+    const float tx = pose.getTranslation().getX();
+    const float ty = pose.getTranslation().getY();
+    const float c = pose.getRotation().getCos();
+    const float s = pose.getRotation().getSin();
+
+    for (int i = 0; i < count; i++) {
+        // Translate to the pose, then rotate by the inverse of its rotation
+        float dx = x[i] - tx;
+        float dy = y[i] - ty;
+        outX[i] = (dx * c) + (dy * s);
+        outY[i] = (dy * c) - (dx * s);
+    }
+}
+
+void batchToGlobalScalar(const float* x, const float* y, float* outX, float* outY, int count, const Pose2& pose) {
+    const float tx = pose.getTranslation().getX();
+    const float ty = pose.getTranslation().getY();
+    const float c = pose.getRotation().getCos();
+    const float s = pose.getRotation().getSin();
+
+    for (int i = 0; i < count; i++) {
+        // Rotate by the pose's rotation, then translate to the pose
+        float px = x[i];
+        float py = y[i];
+        outX[i] = (px * c) - (py * s) + tx;
+        outY[i] = (py * c) + (px * s) + ty;
+    }
+}
+
+#ifdef BATCH_TRANSFORM_NEON
+
+void batchToLocal(const float* x, const float* y, float* outX, float* outY, int count, const Pose2& pose) {
+    const float32x4_t tx = vdupq_n_f32(pose.getTranslation().getX());
+    const float32x4_t ty = vdupq_n_f32(pose.getTranslation().getY());
+    const float32x4_t c = vdupq_n_f32(pose.getRotation().getCos());
+    const float32x4_t s = vdupq_n_f32(pose.getRotation().getSin());
+
+    // Convert 4 points at a time
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t dx = vsubq_f32(vld1q_f32(x + i), tx);
+        float32x4_t dy = vsubq_f32(vld1q_f32(y + i), ty);
+        vst1q_f32(outX + i, vmlaq_f32(vmulq_f32(dx, c), dy, s));
+        vst1q_f32(outY + i, vmlsq_f32(vmulq_f32(dy, c), dx, s));
+    }
+
+    // Convert any left over points
+    batchToLocalScalar(x + i, y + i, outX + i, outY + i, count - i, pose);
+}
+
+void batchToGlobal(const float* x, const float* y, float* outX, float* outY, int count, const Pose2& pose) {
+    const float32x4_t tx = vdupq_n_f32(pose.getTranslation().getX());
+    const float32x4_t ty = vdupq_n_f32(pose.getTranslation().getY());
+    const float32x4_t c = vdupq_n_f32(pose.getRotation().getCos());
+    const float32x4_t s = vdupq_n_f32(pose.getRotation().getSin());
+
+    // Convert 4 points at a time
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t px = vld1q_f32(x + i);
+        float32x4_t py = vld1q_f32(y + i);
+        vst1q_f32(outX + i, vaddq_f32(vmlsq_f32(vmulq_f32(px, c), py, s), tx));
+        vst1q_f32(outY + i, vaddq_f32(vmlaq_f32(vmulq_f32(py, c), px, s), ty));
+    }
+
+    // Convert any left over points
+    batchToGlobalScalar(x + i, y + i, outX + i, outY + i, count - i, pose);
+}
+
+#else
+
+void batchToLocal(const float* x, const float* y, float* outX, float* outY, int count, const Pose2& pose) {
+    batchToLocalScalar(x, y, outX, outY, count, pose);
+}
+
+void batchToGlobal(const float* x, const float* y, float* outX, float* outY, int count, const Pose2& pose) {
+    batchToGlobalScalar(x, y, outX, outY, count, pose);
+}
+
+#endif
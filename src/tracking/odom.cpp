@@ -3,42 +3,70 @@
 #include "globals.h"
 #include "chassis.h"
 #include "serialLogUtil.h"
+#include "tracking/odometry.h"
+#include "tracking/sensorRecorder.h"
+#include <atomic>
 #include <math.h>
 
-// Encoder deltas
-float lDelta = 0; // Delta of distance travelled by left tracking wheel
-float rDelta = 0; // Delta of distance travelled by right tracking wheel
-float bDelta = 0; // Delta of distance travelled by back tracking wheel
+// Dimensions of the robot used for odometry
+const OdomGeometry geometry = {WHEELBASE, BACK_WHEEL_OFFSET, TRACKING_WHEEL_DIAMETER};
 
-// Real world distances
-float lDist = 0; // lDelta in inches
-float rDist = 0; // rDelta in inches
-float bDist = 0; // bDelta in inches
-float aDelta = 0; // Delta of angle in radians
+// Position tracking math, shared with the offline replay tool
+Odometry odometry(geometry);
 
-// Previous encoder values
-float lLast = 0; // Last value of left tracking wheel
-float rLast = 0; // Last value of right tracking wheel
-float bLast = 0; // Last value of back tracking wheel
+// Records raw sensor data for replay
+SensorRecorder recorder;
 
-// Total distances
-float left = 0; // Total distance travelled by left tracking wheel
-float right = 0; // Total distance travelled by right tracking wheel
-float lateral = 0; // Total distance travelled laterally (measured from back tracking wheel)
-float angle = 0; // Current arc angle
-
-Vector2 globalPos(0, 0);
-
-// Constants and macros
-const float lrOffset = WHEELBASE / 2.0f; // Offset of the left / right tracking wheel from the center in terms of x axis
-const float bOffset = -BACK_WHEEL_OFFSET; // Offset of the back tracking wheel from the center in terms of y axis (negative because its in the back)
-
-// Conversion calculations
-#define DRIVE_DEGREE_TO_INCH (M_PI * DRIVE_WHEEL_DIAMETER / 360) 
-#define TRACKING_WHEEL_DEGREE_TO_INCH (M_PI * TRACKING_WHEEL_DIAMETER / 360)
+// Path of a recording requested by startTrackingRecording(), started by the tracking task
+std::atomic<const char*> requestedRecording{NULL};
 
 bool printTracking = true;
 
+// Schedules the tracking loop at a fixed period
+LoopTimer trackingTimer(TRACKING_PERIOD);
+
+void setTrackingPeriod(uint32_t period) {
+    trackingTimer.setPeriod(period);
+}
+
+LoopStats getTrackingStats() {
+    return trackingTimer.getStats();
+}
+
+void startTrackingRecording(const char* path) {
+    requestedRecording = path;
+}
+
+void stopTrackingRecording() {
+    recorder.stop();
+}
+
+/**
+ * Read all the sensors used for odometry
+ * @return The sensor data as a SensorSample
+*/
+static SensorSample readSensors() {
+    SensorSample sample;
+    sample.timestamp = pros::micros();
+    sample.left = lEnc.get_value();
+    sample.right = rEnc.get_value();
+    sample.back = bEnc.get_value();
+    sample.imuRotation = myImu.get_rotation();
+    sample.imuRate = myImu.get_gyro_rate().z;
+    return sample;
+}
+
+/**
+ * Restart odometry from the current pose and sensor values
+ * @return The sensor data odometry was restarted with
+*/
+static SensorSample restartOdometry() {
+    SensorSample start = readSensors();
+    PoseSnapshot pose = trackingData.getSnapshot();
+    odometry.reset(pose.x, pose.y, start);
+    return start;
+}
+
 // Actual tracking function that runs in BG
 void tracking(void* parameter) {
     // Assuming that there are 3 encoders
@@ -50,85 +78,54 @@ void tracking(void* parameter) {
     rEnc.reset();
     bEnc.reset();
 
+    // Start odometry from the current position and IMU angle
+    restartOdometry();
+
+    // Start the fixed-rate schedule
+    trackingTimer.start();
+
     // Tracking loop
     while (true) {
-        Vector2 localPos;
-
-        // Get encoder data
-        float lEncVal = lEnc.get_value();
-        float rEncVal = rEnc.get_value();
-        float bEncVal = bEnc.get_value();
-
-        // Calculate delta values
-        lDelta = lEncVal - lLast;
-        rDelta = rEncVal - rLast;
-        bDelta = bEncVal - bLast;
-
-        // Calculate IRL distances from deltas
-        lDist = lDelta * TRACKING_WHEEL_DEGREE_TO_INCH;
-        rDist = rDelta * TRACKING_WHEEL_DEGREE_TO_INCH;
-        bDist = bDelta * TRACKING_WHEEL_DEGREE_TO_INCH;
-
-        // Update last values for next iter since we don't need to use last values for this iteration
-        lLast = lEncVal;
-        rLast = rEncVal;
-        bLast = bEncVal;
-
-        // Update total distance vars
-        left += lDist;
-        right += rDist;
-        lateral += bDist;
-
-        // Calculate new absolute orientation
-        float prevAngle = angle; // Previous angle, used for delta
-        angle = (right - left) / WHEELBASE;
-
-        // Get angle delta
-        aDelta = angle - prevAngle;
-
-        // Calculate using different formulas based on if orientation change
-        float avgLRDelta = (lDist + rDist) / 2; // Average of delta distance travelled by left and right wheels
-        if (aDelta == 0.0f) {
-            // Set the local positions to the distances travelled since the angle didn't change
-            localPos = Vector2(bDist, avgLRDelta);
-        } else {
-            // Use the angle to calculate the local position since angle did change
-            localPos = Vector2(
-                2 * sin(aDelta / 2) * (bDist / aDelta - bOffset),
-                2 * sin(aDelta / 2) * (rDist / aDelta - lrOffset)
-            );
+        // Start a recording if one was requested, restarting odometry so replay starts from the same state
+        const char* recordingPath = requestedRecording.exchange(NULL);
+        if (recordingPath != NULL) {
+            RecordingHeader header;
+            header.geometry = geometry;
+            header.start = restartOdometry();
+            header.startX = odometry.getPos().getX();
+            header.startY = odometry.getPos().getY();
+
+            if (!recorder.start(recordingPath, header)) {
+                colorPrintf("Could not start recording to %s\n", RED, recordingPath);
+            }
         }
 
-        // Calculate the average orientation
-        // If any issues arise, try changing aDelta to aDelta/2
-        float avgAngle = -(prevAngle + (aDelta / 2));
-
-        // Calculate global offset https://www.mathsisfun.com/polar-cartesian-coordinates.html
-        float globalOffsetX = cos(avgAngle); // cos(θ) = x 
-        float globalOffsetY = sin(avgAngle); // sin(θ) = y 
+        // Get sensor data
+        SensorSample sample = readSensors();
 
-        // Finally, update the global position
-        globalPos = Vector2(
-            trackingData.getPos().getX() + (localPos.getY() * globalOffsetY) + (localPos.getX() * globalOffsetX),
-            trackingData.getPos().getY() + (localPos.getY() * globalOffsetX) - (localPos.getX() * globalOffsetY)
-        );
+        // Store the raw data for replay, then run the tracking math on it
+        recorder.record(sample);
+        odometry.step(sample);
 
         // Update tracking data
-        trackingData.update(globalPos, degToRad(myImu.get_rotation() + 90));
+        trackingData.update(odometry.getPos(), odometry.getHeading());
+        poseHistory.push(trackingData.getSnapshot());
         
         // Debug print
         if (pros::millis() - printTime > 75 && printTracking) {
             // Only print every 75ms to reduce lag
+            PoseSnapshot pose = trackingData.getSnapshot();
             colorPrintf("X: %f, Y: %f, A: %f\n", 
                 GREEN,
-                trackingData.getPos().getX(), 
-                trackingData.getPos().getY(), 
-                radToDeg(trackingData.getHeading())
+                pose.x, 
+                pose.y, 
+                radToDeg(pose.heading)
             );
 
             printTime = pros::millis();
         }
         
-        pros::delay(10); // Max of 10ms
+        // Wait until the next period, regardless of how long this iteration took
+        trackingTimer.wait();
     }
-}
\ No newline at end of file
+}
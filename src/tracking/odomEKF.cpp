@@ -0,0 +1,125 @@
+#include "tracking/odomEKF.h"
+#include <math.h>
+#include "fastTrig.h"
+
+OdomEKF::OdomEKF(double iQDistance, double iQAngle, double iQAngularVelocity, double iRWheelRate, double iRImuAngle, double iRImuRate)
+    : QDistance(iQDistance),
+      QAngle(iQAngle),
+      QAngularVelocity(iQAngularVelocity),
+      RWheelRate(iRWheelRate),
+      RImuAngle(iRImuAngle),
+      RImuRate(iRImuRate) {}
+
+void OdomEKF::reset(double x, double y, double angle) {
+    this->state[X] = x;
+    this->state[Y] = y;
+    this->state[ANGLE] = angle;
+    this->state[ANGULAR_VELOCITY] = 0;
+
+    for (int i = 0; i < STATES; i++) {
+        for (int j = 0; j < STATES; j++) {
+            this->P[i][j] = 0;
+        }
+    }
+}
+
+void OdomEKF::filter(Vector2 localPos, double wheelAngleDelta, double imuAngle, double imuRate, double dt) {
+    if (dt <= 0) {
+        return;
+    }
+
+    // The angular velocity is a random walk, so its uncertainty grows over the step
+    this->P[ANGULAR_VELOCITY][ANGULAR_VELOCITY] += this->QAngularVelocity * dt;
+
+    // Both the tracking wheels and the IMU measure the angular velocity over this step,
+    // so fuse them before using it to predict the rest of the state
+    this->update(ANGULAR_VELOCITY, wheelAngleDelta / dt, this->RWheelRate);
+    this->update(ANGULAR_VELOCITY, imuRate, this->RImuRate);
+
+    // Predict the new pose, rotating the local translation by the average angle over the step
+    // (same convention as the tracking loop)
+    double omega = this->state[ANGULAR_VELOCITY];
+    double avgAngle = -(this->state[ANGLE] + omega * dt / 2);
+    double sinA, cosA;
+    Trig<TRACKING_TRIG_MODE>::sincos(avgAngle, sinA, cosA);
+    double lx = localPos.getX();
+    double ly = localPos.getY();
+
+    this->state[X] += (ly * sinA) + (lx * cosA);
+    this->state[Y] += (ly * cosA) - (lx * sinA);
+    this->state[ANGLE] += omega * dt;
+
+    // Jacobian of the prediction, F = I except for these entries
+    double dXdAngle = -((ly * cosA) - (lx * sinA));
+    double dYdAngle = (ly * sinA) + (lx * cosA);
+    double F[STATES][STATES] = {
+        {1, 0, dXdAngle, dXdAngle * dt / 2},
+        {0, 1, dYdAngle, dYdAngle * dt / 2},
+        {0, 0, 1,        dt},
+        {0, 0, 0,        1}
+    };
+
+    // P = F * P * F^T + Q
+    double FP[STATES][STATES];
+    for (int i = 0; i < STATES; i++) {
+        for (int j = 0; j < STATES; j++) {
+            double sum = 0;
+            for (int k = 0; k < STATES; k++) {
+                sum += F[i][k] * this->P[k][j];
+            }
+            FP[i][j] = sum;
+        }
+    }
+    for (int i = 0; i < STATES; i++) {
+        for (int j = 0; j < STATES; j++) {
+            double sum = 0;
+            for (int k = 0; k < STATES; k++) {
+                sum += FP[i][k] * F[j][k];
+            }
+            this->P[i][j] = sum;
+        }
+    }
+
+    // Position uncertainty grows with distance travelled, angle uncertainty with time
+    double distance = sqrt((lx * lx) + (ly * ly));
+    this->P[X][X] += this->QDistance * distance;
+    this->P[Y][Y] += this->QDistance * distance;
+    this->P[ANGLE][ANGLE] += this->QAngle * dt;
+
+    // Correct the angle with the IMU, using the residual the short way around
+    double residual = imuAngle - this->state[ANGLE];
+    double sinR, cosR;
+    Trig<TRACKING_TRIG_MODE>::sincos(residual, sinR, cosR);
+    residual = Trig<TRACKING_TRIG_MODE>::atan2(sinR, cosR);
+    this->update(ANGLE, this->state[ANGLE] + residual, this->RImuAngle);
+}
+
+void OdomEKF::update(int index, double measurement, double R) {
+    // With H as a unit row, H * P * H^T + R is a single entry and P * H^T is a column
+    double S = this->P[index][index] + R;
+    if (S <= 0) {
+        return;
+    }
+
+    double K[STATES];
+    for (int i = 0; i < STATES; i++) {
+        K[i] = this->P[i][index] / S;
+    }
+
+    // Update the state using the residual
+    double residual = measurement - this->state[index];
+    for (int i = 0; i < STATES; i++) {
+        this->state[i] += K[i] * residual;
+    }
+
+    // P = (I - K * H) * P
+    double row[STATES];
+    for (int j = 0; j < STATES; j++) {
+        row[j] = this->P[index][j];
+    }
+    for (int i = 0; i < STATES; i++) {
+        for (int j = 0; j < STATES; j++) {
+            this->P[i][j] -= K[i] * row[j];
+        }
+    }
+}
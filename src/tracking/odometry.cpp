@@ -0,0 +1,92 @@
+#include "tracking/odometry.h"
+#include <math.h>
+#include "fastTrig.h"
+
+// Conversion calculations
+#define DEGREE_TO_RADIAN (M_PI / 180)
+
+Odometry::Odometry(OdomGeometry geometry) {
+    this->geometry = geometry;
+}
+
+void Odometry::reset(double x, double y, const SensorSample& start) {
+    this->lLast = start.left;
+    this->rLast = start.right;
+    this->bLast = start.back;
+
+    this->left = 0;
+    this->right = 0;
+    this->lateral = 0;
+    this->angle = 0;
+
+    this->lastTime = start.timestamp;
+
+    // The IMU is clockwise positive, the tracking wheels are counter-clockwise positive
+    this->filter.reset(x, y, -start.imuRotation * DEGREE_TO_RADIAN);
+}
+
+double Odometry::getHeading() const {
+    // Heading is clockwise from +y like the IMU, the filter's angle is counter-clockwise
+    return -this->filter.getAngle();
+}
+
+void Odometry::step(const SensorSample& sample) {
+    Vector2 localPos;
+
+    // Constants
+    const double wheelDegreeToInch = this->degreeToInch();
+    const double lrOffset = this->geometry.wheelbase / 2.0; // Offset of the left / right tracking wheel from the center in terms of x axis
+    const double bOffset = -this->geometry.backWheelOffset; // Offset of the back tracking wheel from the center in terms of y axis (negative because its in the back)
+
+    // Calculate delta values in ticks
+    int32_t lDelta = sample.left - this->lLast;
+    int32_t rDelta = sample.right - this->rLast;
+    int32_t bDelta = sample.back - this->bLast;
+
+    // Calculate IRL distances from deltas
+    double lDist = lDelta * wheelDegreeToInch;
+    double rDist = rDelta * wheelDegreeToInch;
+    double bDist = bDelta * wheelDegreeToInch;
+
+    // Update last values for next iter since we don't need to use last values for this iteration
+    this->lLast = sample.left;
+    this->rLast = sample.right;
+    this->bLast = sample.back;
+
+    // Update total distance vars
+    this->left += lDelta;
+    this->right += rDelta;
+    this->lateral += bDelta;
+
+    // Calculate new absolute orientation from the exact tick totals
+    double prevAngle = this->angle; // Previous angle, used for delta
+    this->angle = (this->right - this->left) * wheelDegreeToInch / this->geometry.wheelbase;
+
+    // Get angle delta
+    double aDelta = this->angle - prevAngle;
+
+    // Calculate using different formulas based on if orientation change
+    double avgLRDelta = (lDist + rDist) / 2; // Average of delta distance travelled by left and right wheels
+    if (lDelta == rDelta) {
+        // Set the local positions to the distances travelled since the angle didn't change
+        localPos = Vector2(bDist, avgLRDelta);
+    } else {
+        // Use the angle to calculate the local position since angle did change
+        double chordScale = 2 * Trig<TRACKING_TRIG_MODE>::sin(aDelta / 2);
+        localPos = Vector2(
+            chordScale * (bDist / aDelta - bOffset),
+            chordScale * (rDist / aDelta - lrOffset)
+        );
+    }
+
+    // Time since the last step in seconds (unsigned subtraction handles the timestamp wrapping)
+    double dt = (uint32_t) (sample.timestamp - this->lastTime) / 1000000.0;
+    this->lastTime = sample.timestamp;
+
+    // The IMU is clockwise positive, the tracking wheels are counter-clockwise positive
+    double imuAngle = -sample.imuRotation * DEGREE_TO_RADIAN;
+    double imuRate = -sample.imuRate * DEGREE_TO_RADIAN;
+
+    // Fuse the local translation and angle change with the IMU to get the global position
+    this->filter.filter(localPos, aDelta, imuAngle, imuRate, dt);
+}
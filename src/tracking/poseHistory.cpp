@@ -0,0 +1,100 @@
+#include "tracking/poseHistory.h"
+#include <math.h>
+#include "fastTrig.h"
+
+/**
+ * Wrap an angle in radians to the range [-pi, pi]
+ * @param a The angle to wrap
+*/
+static double wrapAngle(double a) {
+    double s, c;
+    Trig<TRACKING_TRIG_MODE>::sincos(a, s, c);
+    return Trig<TRACKING_TRIG_MODE>::atan2(s, c);
+}
+
+void PoseHistory::push(const PoseSnapshot& pose) {
+    uint32_t seq = this->sequence.load(std::memory_order_relaxed);
+    this->sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (this->count < POSE_HISTORY_LENGTH) {
+        // Append after the newest pose
+        this->poses[(this->head + this->count) % POSE_HISTORY_LENGTH] = pose;
+        this->count++;
+    } else {
+        // Full, so overwrite the oldest pose which makes the next one the oldest
+        this->poses[this->head] = pose;
+        this->head = (this->head + 1) % POSE_HISTORY_LENGTH;
+    }
+
+    this->sequence.store(seq + 2, std::memory_order_release);
+}
+
+bool PoseHistory::poseAt(uint64_t time, PoseSnapshot& pose) const {
+    PoseSnapshot result;
+    bool found;
+    uint32_t start, end;
+
+    do {
+        start = this->sequence.load(std::memory_order_acquire);
+
+        uint32_t head = this->head;
+        uint32_t count = this->count;
+        found = count > 0 && time >= this->at(0, head).timestamp;
+
+        if (found) {
+            if (time >= this->at(count - 1, head).timestamp) {
+                // Newer than anything recorded, use the latest pose
+                result = this->at(count - 1, head);
+            } else {
+                // Binary search for the last pose at or before the time
+                uint32_t low = 0;
+                uint32_t high = count - 1;
+                while (high - low > 1) {
+                    uint32_t mid = low + (high - low) / 2;
+                    if (this->at(mid, head).timestamp <= time) {
+                        low = mid;
+                    } else {
+                        high = mid;
+                    }
+                }
+
+                // Interpolate between the poses on either side of the time
+                const PoseSnapshot& before = this->at(low, head);
+                const PoseSnapshot& after = this->at(high, head);
+                double t = (double) (time - before.timestamp) / (double) (after.timestamp - before.timestamp);
+
+                result.x = before.x + (after.x - before.x) * t;
+                result.y = before.y + (after.y - before.y) * t;
+                // Go the short way around so headings near +-pi don't spin the wrong way
+                result.heading = before.heading + wrapAngle(after.heading - before.heading) * t;
+                Trig<TRACKING_TRIG_MODE>::sincos(result.heading, result.sinHeading, result.cosHeading);
+                result.timestamp = time;
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        end = this->sequence.load(std::memory_order_relaxed);
+        // Retry if a push was in progress or happened during the lookup
+    } while ((start & 1) || start != end);
+
+    if (found) {
+        pose = result;
+    }
+    return found;
+}
+
+uint32_t PoseHistory::size() const {
+    return this->count;
+}
+
+void PoseHistory::clear() {
+    uint32_t seq = this->sequence.load(std::memory_order_relaxed);
+    this->sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    this->head = 0;
+    this->count = 0;
+
+    this->sequence.store(seq + 2, std::memory_order_release);
+}
@@ -0,0 +1,89 @@
+#include "tracking/sensorRecorder.h"
+#include <string.h>
+
+bool SensorRecorder::start(const char* path, RecordingHeader header) {
+    if (this->recording || this->writerTask != NULL) {
+        return false;
+    }
+
+    this->file = fopen(path, "wb");
+    if (this->file == NULL) {
+        return false;
+    }
+
+    // Write the header so the file can be identified and replayed
+    memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+    header.version = RECORDING_VERSION;
+    header.sampleSize = sizeof(SensorSample);
+    fwrite(&header, sizeof(RecordingHeader), 1, this->file);
+
+    this->activeBuffer = 0;
+    this->activeCount = 0;
+    this->pendingBuffer = -1;
+    this->dropped = 0;
+    this->recording = true;
+
+    // Low priority so writing never delays the tasks doing actual work
+    this->writerTask = new pros::Task(writer, this, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "Sensor Recorder");
+    return true;
+}
+
+void SensorRecorder::record(const SensorSample& sample) {
+    if (!this->recording) {
+        return;
+    }
+
+    this->buffers[this->activeBuffer][this->activeCount] = sample;
+    this->activeCount++;
+
+    if (this->activeCount == RECORDER_BUFFER_SAMPLES) {
+        if (this->pendingBuffer == -1) {
+            // Hand the full buffer to the writer and continue in the other one
+            this->pendingBuffer = this->activeBuffer;
+            this->activeBuffer ^= 1;
+            this->writerTask->notify();
+        } else {
+            // The writer is still busy with the other buffer, so this buffer has to be reused
+            this->dropped += RECORDER_BUFFER_SAMPLES;
+        }
+        this->activeCount = 0;
+    }
+}
+
+void SensorRecorder::stop() {
+    if (!this->recording) {
+        return;
+    }
+
+    // The writer flushes the rest of the samples once it sees that recording stopped. It runs at
+    // a lower priority than the recording task, so it can't interrupt a record() in progress.
+    this->recording = false;
+    this->writerTask->notify();
+}
+
+void SensorRecorder::writer(void* param) {
+    SensorRecorder* recorder = (SensorRecorder*) param;
+
+    while (true) {
+        pros::Task::notify_take(true, TIMEOUT_MAX);
+
+        // Write the full buffer if there is one
+        int pending = recorder->pendingBuffer;
+        if (pending != -1) {
+            fwrite(recorder->buffers[pending], sizeof(SensorSample), RECORDER_BUFFER_SAMPLES, recorder->file);
+            recorder->pendingBuffer = -1;
+        }
+
+        if (!recorder->recording) {
+            // Write the partially filled buffer and finish the recording
+            fwrite(recorder->buffers[recorder->activeBuffer], sizeof(SensorSample), recorder->activeCount, recorder->file);
+            fclose(recorder->file);
+            recorder->file = NULL;
+
+            // Let a new recording be started, this task ends when the function returns
+            delete recorder->writerTask;
+            recorder->writerTask = NULL;
+            return;
+        }
+    }
+}
@@ -1,27 +1,50 @@
 #include "tracking.h"
+#include "main.h"
+#include <math.h>
+#include "fastTrig.h"
 
 TrackingData::TrackingData(double x, double y, double h) {
-    this->heading = h;
+    PoseSnapshot initial;
+    initial.x = x;
+    initial.y = y;
+    initial.heading = h;
+    Trig<TRACKING_TRIG_MODE>::sincos(h, initial.sinHeading, initial.cosHeading);
+    this->pose.write(initial);
+}
+
+PoseSnapshot TrackingData::getSnapshot() const {
+    return this->pose.read();
+}
+
+Pose2 TrackingData::getPose() const {
+    PoseSnapshot snapshot = this->getSnapshot();
+    return Pose2(Vector2(snapshot.x, snapshot.y), Rotation2::fromHeading(snapshot.heading, snapshot.cosHeading, snapshot.sinHeading));
 }
 
 double TrackingData::getHeading() {
-    return this->heading;
+    return this->getSnapshot().heading;
 }
 
 Vector2 TrackingData::getPos() {
-    return this->pos;
+    PoseSnapshot snapshot = this->getSnapshot();
+    return Vector2(snapshot.x, snapshot.y);
 }
 
 Vector2 TrackingData::getForward() {
-    return toGlobalCoordinates(Vector2(0, 1));
+    return this->getPose().getRotation().rotate(Vector2(0, 1));
 }
 
 void TrackingData::update(double newX, double newY, double newH) {
-    this->pos = Vector2(newX, newY);
-    this->heading = newH;
+    PoseSnapshot snapshot;
+    snapshot.x = newX;
+    snapshot.y = newY;
+    snapshot.heading = newH;
+    // Computed once here so readers never need to
+    Trig<TRACKING_TRIG_MODE>::sincos(newH, snapshot.sinHeading, snapshot.cosHeading);
+    snapshot.timestamp = pros::micros();
+    this->pose.write(snapshot);
 }
 
 void TrackingData::update(Vector2 newPos, double newH) {
-    this->pos = newPos;
-    this->heading = newH;
-}
\ No newline at end of file
+    this->update(newPos.getX(), newPos.getY(), newH);
+}
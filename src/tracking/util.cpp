@@ -13,22 +13,23 @@ double degToRad(double d) {
 Vector2 rotateVector(Vector2 vec, double angle) {
     // x = cos(a), y = sin(a)
 	// cos(a + b) = cos(a)cos(b) - sin(a)sin(b)
-	double newX = (vec.getX() * cos(angle)) - (vec.getY() * sin(angle));
-
 	// sin(a + b) = sin(a)cos(b) + cos(a)sin(b)
-	double newY = (vec.getY() * cos(angle)) + (vec.getX() * sin(angle));
-
-	return Vector2(newX, newY);
+	return vec.rotate(angle);
 }
 
 Vector2 toLocalCoordinates(Vector2 vec) {
-    double localAngle = -trackingData.getHeading();
-
-	return rotateVector(vec, localAngle);
+	return toLocalCoordinates(vec, trackingData.getPose());
 }
 
 Vector2 toGlobalCoordinates(Vector2 vec) {
-    double localAngle = trackingData.getHeading();
+	return toGlobalCoordinates(vec, trackingData.getPose());
+}
+
+Vector2 toLocalCoordinates(Vector2 vec, const Pose2& pose) {
+    // Reuse the sine and cosine computed when the tracking data was updated
+	return pose.getRotation().unrotate(vec);
+}
 
-	return rotateVector(vec, localAngle);
+Vector2 toGlobalCoordinates(Vector2 vec, const Pose2& pose) {
+	return pose.getRotation().rotate(vec);
 }
\ No newline at end of file
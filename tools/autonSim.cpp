@@ -0,0 +1,130 @@
+/**
+ * \file autonSim.cpp
+ * 
+ * \brief Estimates the time saved by overlapping subsystem actions with asynchronous drive motions.
+ * 
+ * Build and run with:
+ * 
+ *     g++ -O2 -std=gnu++17 -iquote include tools/autonSim.cpp -o autonSim
+ *     ./autonSim [--gain k] [--tau s] [--delay s]
+ * 
+ * Runs a routine like myAuton() with an intake, lift and outtake action, first the blocking
+ * way where every action waits for the one before, then with moveToPointAsync() and
+ * rotateToAsync() where actions start from waitUntilProgress() while the robot drives.
+ * Drive motions are simulated as straight line moves on the drivetrain model with a copy of
+ * DrivetrainPID's PID loop and settle criteria, not with DrivetrainPID and the motion task
+ * themselves (they need PROS), and subsystem actions take fixed times. The results are estimates
+ * for the model only and should be checked with a stopwatch on the robot.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "control/policyPID.h"
+#include "plantModel.h"
+
+/**
+ * Distance between the left and right wheels in inches, the same as WHEELBASE in chassis.h
+*/
+#define SIM_WHEELBASE 10.25
+
+/**
+ * Longest simulated motion in seconds
+*/
+#define SIM_TIMEOUT 10
+
+/**
+ * \brief A simulated drive motion
+*/
+class Motion {
+    public:
+        /**
+         * Simulate a motion of a distance, measured along the wheels for turns
+        */
+        Motion(double gain, double tau, double delay, double distance) {
+            Plant plant(gain, tau, delay);
+            PIDInfo constants;
+            constants.p = 8;
+            constants.i = 0;
+            constants.d = 0.5;
+            PID<PIDPolicy::OutputLimit> controller(constants, PIDPolicy::OutputLimit());
+            controller.target = distance;
+
+            // Same settle criteria as DrivetrainPID's default tolerance
+            double settleTime = 0;
+            for (this->steps = 0; this->steps < SIM_TIMEOUT / SIM_DT; this->steps++) {
+                plant.step(controller.step(plant.getPosition(), SIM_DT));
+                this->progress[this->steps] = fmax(0, fmin(1, plant.getPosition() / distance));
+
+                bool inBand = fabs(distance - plant.getPosition()) <= 1 && fabs(plant.getVelocity()) <= 2;
+                settleTime = inBand ? settleTime + SIM_DT : 0;
+                if (settleTime >= 0.25) {
+                    break;
+                }
+            }
+        };
+
+        /**
+         * Returns the time the motion takes in seconds
+        */
+        double getDuration() const { return this->steps * SIM_DT; };
+
+        /**
+         * Returns the time at which a fraction of the motion has been completed, like waitUntilProgress()
+        */
+        double timeAtProgress(double fraction) const {
+            for (int i = 0; i < this->steps; i++) {
+                if (this->progress[i] >= fraction) {
+                    return i * SIM_DT;
+                }
+            }
+            return this->getDuration();
+        };
+
+    private:
+        double progress[(int) (SIM_TIMEOUT / SIM_DT) + 1];
+        int steps;
+};
+
+int main(int argc, char** argv) {
+    double gain = 0.27, tau = 0.15, delay = 0.03;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--gain") == 0 && hasValue) {
+            gain = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tau") == 0 && hasValue) {
+            tau = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--delay") == 0 && hasValue) {
+            delay = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--gain k] [--tau s] [--delay s]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Subsystem actions in seconds
+    const double intakeTime = 1.0, liftTime = 1.2, outtakeTime = 0.8;
+
+    // Drive 24in to a game object, turn 90 degrees towards the goal, and drive 36in to it
+    Motion toObject(gain, tau, delay, 24);
+    Motion turn(gain, tau, delay, M_PI / 2 * SIM_WHEELBASE / 2);
+    Motion toGoal(gain, tau, delay, 36);
+
+    // Blocking: every action waits for the one before
+    double blocking = toObject.getDuration() + intakeTime + turn.getDuration() + liftTime + toGoal.getDuration() + outtakeTime;
+
+    // Async: the intake runs while driving to the object, the lift rises while turning, and the
+    // outtake starts once the robot is 90% of the way to the goal
+    double async = fmax(toObject.getDuration(), intakeTime)
+                 + fmax(turn.getDuration(), liftTime)
+                 + fmax(toGoal.getDuration(), toGoal.timeAtProgress(0.9) + outtakeTime);
+
+    printf("model only: drive 24in %.2fs, turn 90deg %.2fs, drive 36in %.2fs\n", toObject.getDuration(), turn.getDuration(), toGoal.getDuration());
+    printf("blocking routine %.2fs\n", blocking);
+    printf("async routine    %.2fs\n", async);
+    printf("saved            %.2fs (%.0f%%)\n", blocking - async, 100 * (blocking - async) / blocking);
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * \file batchTransformCheck.cpp
+ *
+ * \brief Checks batchToLocal() and batchToGlobal() against the scalar versions and Pose2, and measures their throughput.
+ *
+ * Build and run the scalar path with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include tools/batchTransformCheck.cpp src/tracking/batchTransform.cpp -o batchTransformCheck
+ *     ./batchTransformCheck
+ *
+ * The NEON path can be run on a computer without an ARM toolchain through the stand in
+ * intrinsics in tools/neonShim, which checks its lane handling and left over points but not the
+ * real instructions:
+ *
+ *     g++ -O2 -std=gnu++17 -D__ARM_NEON -I tools/neonShim -iquote include tools/batchTransformCheck.cpp \
+ *         src/tracking/batchTransform.cpp -o batchTransformCheck
+ *
+ * With the PROS toolchain, the real NEON path is compiled with the same flags as common.mk, and
+ * the check can be run on the V5 or under qemu-arm:
+ *
+ *     arm-none-eabi-g++ -mcpu=cortex-a9 -mfpu=neon-fp16 -mfloat-abi=softfp -O2 -std=gnu++17 -iquote include \
+ *         tools/batchTransformCheck.cpp src/tracking/batchTransform.cpp -specs=rdimon.specs -o batchTransformCheck
+ *
+ * Exits with 1 if any output differs from the scalar version or from Pose2 by more than the
+ * tolerance.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "tracking/batchTransform.h"
+
+/**
+ * Largest allowed difference from the scalar version in inches. The NEON path does the same float
+ * operations in the same order, so this only allows for the last bit of rounding
+*/
+#define SCALAR_TOLERANCE 1e-5
+
+/**
+ * Largest allowed difference from Pose2's double math in inches, a few float epsilons at 150"
+*/
+#define POSE_TOLERANCE 1e-4
+
+/**
+ * Number of points converted per timed call
+*/
+#define BENCH_POINTS 1024
+
+/**
+ * Number of timed calls per version
+*/
+#define BENCH_REPEATS 20000
+
+/**
+ * Sink for results so the compiler can't remove the work being timed
+*/
+static volatile float sink;
+
+/**
+ * Returns a random value in range [low, high]
+*/
+static double random(double low, double high) {
+    return low + (high - low) * rand() / RAND_MAX;
+}
+
+/**
+ * Compare each conversion of count random points to the scalar version and Pose2
+ * @return The largest differences from the scalar version and from Pose2
+*/
+static void compare(int count, const Pose2& pose, double& scalarError, double& poseError) {
+    std::vector<float> x(count), y(count);
+    for (int i = 0; i < count; i++) {
+        x[i] = random(-144, 144);
+        y[i] = random(-144, 144);
+    }
+
+    std::vector<float> localX(count), localY(count), scalarX(count), scalarY(count);
+    batchToLocal(x.data(), y.data(), localX.data(), localY.data(), count, pose);
+    batchToLocalScalar(x.data(), y.data(), scalarX.data(), scalarY.data(), count, pose);
+    for (int i = 0; i < count; i++) {
+        Vector2 expected = pose.toLocal(Vector2(x[i], y[i]));
+        scalarError = fmax(scalarError, fmax(fabs(localX[i] - scalarX[i]), fabs(localY[i] - scalarY[i])));
+        poseError = fmax(poseError, fmax(fabs(localX[i] - expected.getX()), fabs(localY[i] - expected.getY())));
+    }
+
+    std::vector<float> globalX(count), globalY(count);
+    batchToGlobal(x.data(), y.data(), globalX.data(), globalY.data(), count, pose);
+    batchToGlobalScalar(x.data(), y.data(), scalarX.data(), scalarY.data(), count, pose);
+    for (int i = 0; i < count; i++) {
+        Vector2 expected = pose.toGlobal(Vector2(x[i], y[i]));
+        scalarError = fmax(scalarError, fmax(fabs(globalX[i] - scalarX[i]), fabs(globalY[i] - scalarY[i])));
+        poseError = fmax(poseError, fmax(fabs(globalX[i] - expected.getX()), fabs(globalY[i] - expected.getY())));
+    }
+
+    // Converting in place should give the same result
+    batchToLocal(x.data(), y.data(), x.data(), y.data(), count, pose);
+    for (int i = 0; i < count; i++) {
+        scalarError = fmax(scalarError, fmax(fabs(x[i] - localX[i]), fabs(y[i] - localY[i])));
+    }
+}
+
+/**
+ * Time a conversion of BENCH_POINTS points
+ * @return Points converted per microsecond
+*/
+template <typename Convert>
+static double pointsPerMicrosecond(Convert convert) {
+    std::vector<float> x(BENCH_POINTS), y(BENCH_POINTS), outX(BENCH_POINTS), outY(BENCH_POINTS);
+    for (int i = 0; i < BENCH_POINTS; i++) {
+        x[i] = random(-144, 144);
+        y[i] = random(-144, 144);
+    }
+
+    float total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        Pose2 pose(Vector2(r % 7, r % 5), Rotation2(r * 0.001));
+        convert(x.data(), y.data(), outX.data(), outY.data(), BENCH_POINTS, pose);
+        total += outX[r % BENCH_POINTS];
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    sink = total;
+    return (double) BENCH_POINTS * BENCH_REPEATS / elapsed.count();
+}
+
+int main() {
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    printf("batchToLocal() and batchToGlobal() use the NEON path\n\n");
+#else
+    printf("batchToLocal() and batchToGlobal() use the scalar path\n\n");
+#endif
+
+    // Every count up to a few groups of 4 exercises the left over points, then some longer runs
+    srand(1);
+    double scalarError = 0, poseError = 0;
+    for (int trial = 0; trial < 200; trial++) {
+        int count = trial < 40 ? trial : (int) random(40, 1000);
+        Pose2 pose(Vector2(random(-144, 144), random(-144, 144)), Rotation2(random(-M_PI, M_PI)));
+        compare(count, pose, scalarError, poseError);
+    }
+
+    bool passed = scalarError <= SCALAR_TOLERANCE && poseError <= POSE_TOLERANCE;
+    printf("%-4s largest difference from the scalar version %.3g in (tolerance %.0e)\n",
+        scalarError <= SCALAR_TOLERANCE ? "ok" : "FAIL", scalarError, SCALAR_TOLERANCE);
+    printf("%-4s largest difference from Pose2              %.3g in (tolerance %.0e)\n\n",
+        poseError <= POSE_TOLERANCE ? "ok" : "FAIL", poseError, POSE_TOLERANCE);
+
+    printf("%-28s %12s\n", "conversion", "points/us");
+    printf("%-28s %12.1f\n", "batchToLocal", pointsPerMicrosecond(batchToLocal));
+    printf("%-28s %12.1f\n", "batchToLocalScalar", pointsPerMicrosecond(batchToLocalScalar));
+    printf("%-28s %12.1f\n", "batchToGlobal", pointsPerMicrosecond(batchToGlobal));
+    printf("%-28s %12.1f\n", "batchToGlobalScalar", pointsPerMicrosecond(batchToGlobalScalar));
+    printf("%-28s %12.1f\n", "Pose2::toLocal per point", pointsPerMicrosecond(
+        [](const float* x, const float* y, float* outX, float* outY, int count, const Pose2& pose) {
+            for (int i = 0; i < count; i++) {
+                Vector2 local = pose.toLocal(Vector2(x[i], y[i]));
+                outX[i] = local.getX();
+                outY[i] = local.getY();
+            }
+        }));
+
+    return passed ? 0 : 1;
+}
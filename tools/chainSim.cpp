@@ -0,0 +1,194 @@
+/**
+ * \file chainSim.cpp
+ * 
+ * \brief Compares driving a multi-waypoint route with motion chaining against stopping and settling at every waypoint.
+ * 
+ * Build and run with:
+ * 
+ *     g++ -O2 -std=gnu++17 -iquote include tools/chainSim.cpp src/tracking/odometry.cpp src/tracking/odomEKF.cpp -o chainSim
+ *     ./chainSim [--exit-radius in] [--min-speed power] [--tau s] [--delay s]
+ * 
+ * Uses a differential drive model with one Plant per side, tracked by the real Odometry class,
+ * and a copy of the control law in DrivetrainPID::runMoveToPoint: turn in place to face each
+ * waypoint then steer to it and settle, or with chaining, steer through each waypoint and hand
+ * off inside the exit radius. DrivetrainPID itself needs PROS, so the times are for this model
+ * and this copy of the control law only, and should be checked against the robot.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "control/policyPID.h"
+#include "trackedRobot.h"
+
+/**
+ * Distance between the left and right wheels in inches, the same as WHEELBASE in chassis.h
+*/
+#define SIM_WHEELBASE 10.25
+
+/**
+ * Longest simulated route in seconds
+*/
+#define SIM_TIMEOUT 30
+
+/**
+ * Distance inside which driving stops steering, the same as MOVE_TO_POINT_STEER_DISTANCE in drivetrainPID.h
+*/
+#define MOVE_TO_POINT_STEER_DISTANCE 2
+
+/**
+ * \brief Tracks whether a value has stayed within a band for the settle dwell time
+*/
+class Settler {
+    public:
+        Settler(double errorBand, double velocityBand) : errorBand(errorBand), velocityBand(velocityBand) {};
+
+        /**
+         * Returns true once the error and velocity have stayed in their bands for 0.25s, like DEFAULT_SETTLE_DWELL
+        */
+        bool step(double error, double velocity) {
+            bool inBand = fabs(error) <= this->errorBand && fabs(velocity) <= this->velocityBand;
+            this->time = inBand ? this->time + SIM_DT : 0;
+            return this->time >= 0.25;
+        };
+
+    private:
+        double errorBand, velocityBand;
+        double time = 0;
+};
+
+/**
+ * Send forward and clockwise turn outputs to the robot, like DrivetrainPID::driveArcade
+*/
+static void arcade(TrackedRobot& robot, double forward, double turn) {
+    double scale = fabs(forward) + fabs(turn) > 127 ? (127 - fmin(fabs(turn), 127)) / fabs(forward) : 1;
+    robot.step(forward * scale + turn, forward * scale - turn);
+}
+
+/**
+ * Returns the heading error from the tracked pose to a point
+*/
+static double headingTo(const TrackedRobot& robot, Vector2 point) {
+    return remainder((point - robot.getPos()).getHeading() - robot.getHeading(), 2 * M_PI);
+}
+
+/**
+ * Turn in place to face a point until settled
+*/
+static void turnToFace(TrackedRobot& robot, PIDInfo turnConstants, Vector2 point) {
+    PID<PIDPolicy::OutputLimit> controller(turnConstants, PIDPolicy::OutputLimit());
+    Settler settler(M_PI / 180, 0.2);
+    double target = robot.getHeading() + headingTo(robot, point);
+    controller.target = target;
+
+    while (robot.robot.time < SIM_TIMEOUT) {
+        double last = robot.getHeading();
+        double turn = controller.step(last, SIM_DT);
+        robot.step(turn, -turn);
+        if (settler.step(target - robot.getHeading(), (robot.getHeading() - last) / SIM_DT)) {
+            break;
+        }
+    }
+}
+
+/**
+ * Drive to a point like DrivetrainPID::runMoveToPoint
+ * @param exitRadius Hand off inside this distance, 0 to settle
+*/
+static void driveTo(TrackedRobot& robot, PIDInfo driveConstants, PIDInfo turnConstants, Vector2 point, double exitRadius, double minSpeed) {
+    PID<PIDPolicy::OutputLimit> controller(driveConstants, PIDPolicy::OutputLimit());
+    Settler settler(0.5, 2);
+    Vector2 startDelta = point - robot.getPos();
+    double steerDistance = fmax(MOVE_TO_POINT_STEER_DISTANCE, 0.5);
+
+    while (robot.robot.time < SIM_TIMEOUT) {
+        Vector2 last = robot.getPos();
+        Vector2 delta = point - last;
+        double distance = delta.getMagnitude();
+        if (exitRadius > 0 && (distance <= exitRadius || delta.dot(startDelta) < 0)) {
+            break;
+        }
+
+        double vel = -controller.step(distance, SIM_DT);
+        if (exitRadius > 0) {
+            vel = fmax(fabs(vel), minSpeed);
+        }
+
+        double headingError = headingTo(robot, point);
+        double forward = fabs(vel) * cos(headingError);
+        double turn = 0;
+        if (distance > steerDistance) {
+            if (forward < 0) {
+                headingError = remainder(headingError + M_PI, 2 * M_PI);
+            }
+            turn = turnConstants.p * headingError;
+        }
+        arcade(robot, forward, turn);
+
+        if (exitRadius == 0 && settler.step(distance, (robot.getPos() - last).getMagnitude() / SIM_DT)) {
+            break;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    double tau = 0.15, delay = 0.03;
+    double exitRadius = 6, minSpeed = 50;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--exit-radius") == 0 && hasValue) {
+            exitRadius = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--min-speed") == 0 && hasValue) {
+            minSpeed = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tau") == 0 && hasValue) {
+            tau = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--delay") == 0 && hasValue) {
+            delay = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--exit-radius in] [--min-speed power] [--tau s] [--delay s]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    PIDInfo driveConstants, turnConstants;
+    driveConstants.p = 8;
+    driveConstants.i = 0;
+    driveConstants.d = 0.5;
+    turnConstants.p = 60;
+    turnConstants.i = 0;
+    turnConstants.d = 4;
+
+    const Vector2 route[] = {Vector2(0, 24), Vector2(24, 48), Vector2(48, 48), Vector2(60, 72), Vector2(48, 96)};
+    const int waypoints = sizeof(route) / sizeof(route[0]);
+    const Vector2 end = route[waypoints - 1];
+
+    // Stop and settle: turn in place, then drive straight and settle at every waypoint
+    TrackedRobot settling(SensorRobot(SIM_WHEELBASE, 0, tau, delay), SIM_WHEELBASE);
+    for (int i = 0; i < waypoints; i++) {
+        turnToFace(settling, turnConstants, route[i]);
+        driveTo(settling, driveConstants, turnConstants, route[i], 0, 0);
+    }
+
+    // Chained: steer through every waypoint and only settle at the last
+    TrackedRobot chained(SensorRobot(SIM_WHEELBASE, 0, tau, delay), SIM_WHEELBASE);
+    bool carrying = false;
+    for (int i = 0; i < waypoints; i++) {
+        if (!carrying || fabs(headingTo(chained, route[i])) > M_PI / 4) {
+            turnToFace(chained, turnConstants, route[i]);
+        }
+        bool last = i == waypoints - 1;
+        driveTo(chained, driveConstants, turnConstants, route[i], last ? 0 : exitRadius, minSpeed);
+        carrying = !last;
+    }
+
+    // Model results only, the control law above is a copy of DrivetrainPID's rather than the real thing
+    double settlingTime = settling.robot.time, chainedTime = chained.robot.time;
+    printf("model only: route of %d waypoints, exit radius %.1fin, min speed %.0f\n", waypoints, exitRadius, minSpeed);
+    printf("  stop and settle  %5.2fs  final error %.3fin\n", settlingTime, (end - settling.robot.getPos()).getMagnitude());
+    printf("  chained          %5.2fs  final error %.3fin\n", chainedTime, (end - chained.robot.getPos()).getMagnitude());
+    printf("  saved            %5.2fs (%.0f%%)\n", settlingTime - chainedTime, 100 * (settlingTime - chainedTime) / settlingTime);
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * \file driveSim.cpp
+ * 
+ * \brief Compares pure PID drive motions against profiled feedforward + PID motions on a drivetrain model.
+ * 
+ * Build and run with:
+ * 
+ *     g++ -O2 -std=gnu++17 -iquote include tools/driveSim.cpp src/control/motionProfile.cpp \
+ *         src/control/profileFollower.cpp -o driveSim
+ *     ./driveSim [--gain k] [--tau s] [--delay s] [--kP p] [--kD d]
+ * 
+ * The pure PID motion steps the same way DrivetrainPID::moveToPoint does. The profiled motion
+ * uses the same ProfileFollower as ProfiledDrive, with feedforward constants taken from the model.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "control/policyPID.h"
+#include "control/profileFollower.h"
+#include "plantModel.h"
+
+/**
+ * Longest simulated motion in seconds
+*/
+#define SIM_TIMEOUT 10
+
+/**
+ * \brief How a simulated motion went
+*/
+struct MotionResult {
+    double time = -1; // Time to settle in seconds, -1 if it never settled
+    double overshoot = 0; // Largest distance past the target
+    double finalError = 0; // Distance from the target at the end
+};
+
+/**
+ * Returns the settle criteria used for both kinds of motion
+*/
+static SettleCriteria settleCriteria() {
+    SettleCriteria criteria;
+    criteria.errorBand = 0.5;
+    criteria.velocityBand = 2;
+    criteria.dwellTime = 0.1;
+    criteria.timeout = 0;
+    criteria.chainBand = 0;
+    return criteria;
+}
+
+/**
+ * Track a motion's overshoot and settling, shared by both kinds of motion
+*/
+static void record(MotionResult& result, double position, double velocity, double distance, double t, double& settleTime) {
+    SettleCriteria criteria = settleCriteria();
+    double error = distance - position;
+    result.overshoot = fmax(result.overshoot, -error);
+    result.finalError = error;
+
+    if (fabs(error) <= criteria.errorBand && fabs(velocity) <= criteria.velocityBand) {
+        settleTime += SIM_DT;
+        if (settleTime >= criteria.dwellTime && result.time < 0) {
+            result.time = t;
+        }
+    } else {
+        settleTime = 0;
+        result.time = -1;
+    }
+}
+
+/**
+ * Drive a distance with only PID on the distance error, like DrivetrainPID::moveToPoint
+*/
+static MotionResult simulatePID(Plant plant, PIDInfo constants, double distance) {
+    PID<PIDPolicy::OutputLimit> controller(constants, PIDPolicy::OutputLimit());
+    controller.target = distance;
+
+    MotionResult result;
+    double settleTime = 0;
+    for (double t = SIM_DT; t <= SIM_TIMEOUT; t += SIM_DT) {
+        plant.step(controller.step(plant.getPosition(), SIM_DT));
+        record(result, plant.getPosition(), plant.getVelocity(), distance, t, settleTime);
+    }
+    return result;
+}
+
+/**
+ * Drive a distance along a motion profile with feedforward + PID, like ProfiledDrive::driveDistance
+*/
+static MotionResult simulateProfiled(Plant plant, Feedforward feedforward, PIDInfo constants, ProfileConstraints constraints, double distance) {
+    ProfileFollower follower(feedforward, constants, settleCriteria());
+    MotionProfile profile(distance, constraints);
+    follower.start(profile, 0);
+
+    MotionResult result;
+    double settleTime = 0;
+    for (double t = SIM_DT; t <= SIM_TIMEOUT; t += SIM_DT) {
+        plant.step(follower.step(plant.getPosition(), SIM_DT));
+        record(result, plant.getPosition(), plant.getVelocity(), distance, t, settleTime);
+    }
+    return result;
+}
+
+/**
+ * Print a motion's result
+*/
+static void print(const char* name, MotionResult result) {
+    printf("  %-9s ", name);
+    if (result.time >= 0) {
+        printf("settles in %5.2fs", result.time);
+    } else {
+        printf("never settles    ");
+    }
+    printf("  overshoot %5.2fin  final error %6.3fin\n", result.overshoot, result.finalError);
+}
+
+int main(int argc, char** argv) {
+    // A 200 rpm drive on 3.25" wheels tops out around 34 in/s
+    double gain = 0.27, tau = 0.15, delay = 0.03;
+    PIDInfo constants;
+    constants.p = 8;
+    constants.i = 0;
+    constants.d = 0.5;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--gain") == 0 && hasValue) {
+            gain = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tau") == 0 && hasValue) {
+            tau = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--delay") == 0 && hasValue) {
+            delay = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--kP") == 0 && hasValue) {
+            constants.p = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--kD") == 0 && hasValue) {
+            constants.d = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--gain k] [--tau s] [--delay s] [--kP p] [--kD d]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Feedforward from the model: kV cancels the gain and kA cancels the time constant
+    Feedforward feedforward(0, 1 / gain, tau / gain);
+    ProfileConstraints constraints(0.9 * 127 * gain, 120);
+
+    const double distances[] = {6, 12, 24, 48, 96};
+    for (double distance : distances) {
+        Plant plant(gain, tau, delay);
+        printf("%.0f in\n", distance);
+        print("pid", simulatePID(plant, constants, distance));
+        print("profiled", simulateProfiled(plant, feedforward, constants, constraints, distance));
+    }
+
+    return 0;
+}
@@ -0,0 +1,321 @@
+/**
+ * \file ekfCheck.cpp
+ *
+ * \brief Checks how closely the EKF in Odometry tracks a simulated robot with imperfect sensors, and times its step.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include tools/ekfCheck.cpp src/tracking/odometry.cpp src/tracking/odomEKF.cpp -o ekfCheck
+ *     ./ekfCheck [--save recording.bin]
+ *
+ * Drives a simulated robot around a weaving route for 60 seconds and records SensorSamples the way
+ * the tracking task does, with sensor errors like the real ones:
+ * - tracking wheels that are slightly off their nominal diameter and slip a little every step
+ * - an IMU whose scale is slightly off after calibration, that drifts slowly, and has noise on
+ *   its angle and rate
+ *
+ * Each recording is replayed through three ways of tracking:
+ * - wheels only, the tracking loop before the EKF, which rotated by the tracking wheel angle
+ *   and only took its published heading from the IMU
+ * - IMU angle, rotating the same local translation by the IMU angle instead
+ * - the real Odometry class, fusing both with OdomEKF
+ *
+ * and each is compared to the true path. --save writes the first recording in the format
+ * odomReplay reads. Then the cost of Odometry::step() and OdomEKF::filter() is timed. Exits with 1
+ * if the EKF tracks worse than wheels only, more than IMU_MARGIN worse than the IMU angle, or its
+ * largest position error in any run goes over EKF_BOUND.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "tracking/odometry.h"
+
+/**
+ * Distance between the left and right tracking wheels in inches, the same as WHEELBASE in chassis.h
+*/
+#define SIM_WHEELBASE 10.25
+
+/**
+ * Diameter of the tracking wheels in inches, the same as TRACKING_WHEEL_DIAMETER in chassis.h
+*/
+#define SIM_TRACKING_WHEEL_DIAMETER 2.75
+
+/**
+ * Period of the tracking loop in seconds, the same as TRACKING_PERIOD in chassis.h
+*/
+#define SIM_PERIOD 0.01
+
+/**
+ * Number of substeps the true motion is integrated with per tracking period
+*/
+#define SIM_SUBSTEPS 10
+
+/**
+ * Length of each recording in seconds
+*/
+#define SIM_DURATION 60
+
+/**
+ * Number of recordings, each with its own random sensor errors
+*/
+#define SIM_RUNS 20
+
+/**
+ * Largest allowed position error of the EKF at any point in any run, in inches. The IMU's scale
+ * error over all the turning dominates, the worst run measured 6.45in
+*/
+#define EKF_BOUND 8
+
+/**
+ * How much worse than the IMU angle alone the EKF may track on average, as a fraction. The filter
+ * trusts the IMU's angle far more than the wheels', so it should track about the same
+*/
+#define IMU_MARGIN 0.05
+
+/**
+ * Number of timed steps for the benchmark
+*/
+#define BENCH_STEPS 2000000
+
+/**
+ * Sink for results so the compiler can't remove the work being timed
+*/
+static volatile double sink;
+
+/**
+ * \brief A simulated run: the sensor readings and where the robot really was at each one
+*/
+struct Recording {
+    SensorSample start;
+    std::vector<SensorSample> samples;
+    std::vector<Vector2> truth;
+};
+
+/**
+ * Drive the weaving route and record what imperfect sensors would read
+ * @param seed Seed for the sensor errors
+*/
+static Recording record(unsigned seed) {
+    std::mt19937 random(seed);
+    std::normal_distribution<double> normal(0, 1);
+
+    // Errors fixed for the run: tracking wheel diameters and the IMU's scale within 0.2%, and the
+    // IMU drifting up to 1 degree per minute
+    double leftScale = 1 + 0.002 * (2.0 * random() / random.max() - 1);
+    double rightScale = 1 + 0.002 * (2.0 * random() / random.max() - 1);
+    double imuScale = 1 + 0.002 * (2.0 * random() / random.max() - 1);
+    double imuDrift = (2.0 * random() / random.max() - 1) / 60 * M_PI / 180;
+
+    // Noise each step: wheel slip, IMU angle and rate noise
+    const double slip = 0.002, angleNoise = 0.05 * M_PI / 180, rateNoise = 0.3 * M_PI / 180;
+    const double inchPerTick = M_PI * SIM_TRACKING_WHEEL_DIAMETER / 360;
+
+    Recording recording;
+    recording.start = SensorSample{0, 0, 0, 0, 0, 0};
+    double x = 0, y = 0, rotation = 0; // Clockwise from +y, like the IMU
+    double leftMeasured = 0, rightMeasured = 0;
+    for (int step = 1; step * SIM_PERIOD <= SIM_DURATION; step++) {
+        double rate = 0;
+        for (int sub = 0; sub < SIM_SUBSTEPS; sub++) {
+            // Weave at 20 to 40 in/s, turning up to 3 rad/s
+            double t = (step - 1 + (sub + 0.5) / SIM_SUBSTEPS) * SIM_PERIOD;
+            double speed = 30 + 10 * sin(0.3 * t);
+            rate = 2 * sin(0.7 * t) + sin(1.9 * t);
+            double dt = SIM_PERIOD / SIM_SUBSTEPS;
+
+            double middle = rotation + rate * dt / 2;
+            x += speed * dt * sin(middle);
+            y += speed * dt * cos(middle);
+            rotation += rate * dt;
+
+            // The left wheel goes further when turning clockwise
+            leftMeasured += (speed + rate * SIM_WHEELBASE / 2) * dt * leftScale;
+            rightMeasured += (speed - rate * SIM_WHEELBASE / 2) * dt * rightScale;
+        }
+        leftMeasured += slip * normal(random);
+        rightMeasured += slip * normal(random);
+
+        double t = step * SIM_PERIOD;
+        SensorSample sample;
+        sample.timestamp = (uint32_t) llround(t * 1000000);
+        sample.left = (int32_t) lround(leftMeasured / inchPerTick);
+        sample.right = (int32_t) lround(rightMeasured / inchPerTick);
+        sample.back = 0;
+        sample.imuRotation = (rotation * imuScale + imuDrift * t + angleNoise * normal(random)) * 180 / M_PI;
+        sample.imuRate = (rate * imuScale + imuDrift + rateNoise * normal(random)) * 180 / M_PI;
+        recording.samples.push_back(sample);
+        recording.truth.push_back(Vector2(x, y));
+    }
+    return recording;
+}
+
+/**
+ * \brief Position tracking without the EKF, rotating each step's local translation by one angle
+*/
+class PlainOdometry {
+    public:
+        /**
+         * @param useImu Rotate by the IMU angle instead of the tracking wheel angle
+        */
+        PlainOdometry(bool useImu) : useImu(useImu) {};
+
+        void step(const SensorSample& sample) {
+            const double inchPerTick = M_PI * SIM_TRACKING_WHEEL_DIAMETER / 360;
+            double lDist = (sample.left - this->lLast) * inchPerTick;
+            double rDist = (sample.right - this->rLast) * inchPerTick;
+            this->lLast = sample.left;
+            this->rLast = sample.right;
+
+            // Counter-clockwise angles like the tracking wheels
+            double wheelDelta = (rDist - lDist) / SIM_WHEELBASE;
+            double localY = (lDist + rDist) / 2;
+            if (wheelDelta != 0) {
+                localY = 2 * sin(wheelDelta / 2) * (rDist / wheelDelta - SIM_WHEELBASE / 2);
+            }
+
+            // Rotate by the average angle over the step
+            double angle = this->useImu ? -sample.imuRotation * M_PI / 180 : this->wheelAngle + wheelDelta;
+            double average = -(this->lastAngle + angle) / 2;
+            this->x += localY * sin(average);
+            this->y += localY * cos(average);
+            this->lastAngle = angle;
+            this->wheelAngle += wheelDelta;
+        };
+
+        Vector2 getPos() const { return Vector2(this->x, this->y); };
+
+    private:
+        bool useImu;
+        int32_t lLast = 0, rLast = 0;
+        double wheelAngle = 0, lastAngle = 0;
+        double x = 0, y = 0;
+};
+
+/**
+ * \brief Position errors of one way of tracking over a run, in inches
+*/
+struct Errors {
+    double final = 0;
+    double largest = 0;
+
+    void add(Vector2 estimate, Vector2 truth) {
+        this->final = (estimate - truth).getMagnitude();
+        this->largest = fmax(this->largest, this->final);
+    };
+};
+
+/**
+ * Write a recording in the format startTrackingRecording() writes and odomReplay reads
+*/
+static bool save(const char* path, const Recording& recording) {
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+
+    RecordingHeader header;
+    memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+    header.version = RECORDING_VERSION;
+    header.sampleSize = sizeof(SensorSample);
+    header.geometry = OdomGeometry{SIM_WHEELBASE, 0, SIM_TRACKING_WHEEL_DIAMETER};
+    header.startX = 0;
+    header.startY = 0;
+    header.start = recording.start;
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+        && fwrite(recording.samples.data(), sizeof(SensorSample), recording.samples.size(), file) == recording.samples.size();
+    fclose(file);
+    return written;
+}
+
+int main(int argc, char** argv) {
+    const char* savePath = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            savePath = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--save recording.bin]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Errors wheelTotal, imuTotal, ekfTotal;
+    double ekfWorst = 0;
+    for (int run = 0; run < SIM_RUNS; run++) {
+        Recording recording = record(run + 1);
+        if (run == 0 && savePath != NULL && !save(savePath, recording)) {
+            fprintf(stderr, "%s: could not write recording\n", savePath);
+            return 1;
+        }
+
+        PlainOdometry wheels(false), imu(true);
+        Odometry odometry(OdomGeometry{SIM_WHEELBASE, 0, SIM_TRACKING_WHEEL_DIAMETER});
+        odometry.reset(0, 0, recording.start);
+        Errors wheelErrors, imuErrors, ekfErrors;
+        for (size_t i = 0; i < recording.samples.size(); i++) {
+            wheels.step(recording.samples[i]);
+            imu.step(recording.samples[i]);
+            odometry.step(recording.samples[i]);
+            wheelErrors.add(wheels.getPos(), recording.truth[i]);
+            imuErrors.add(imu.getPos(), recording.truth[i]);
+            ekfErrors.add(odometry.getPos(), recording.truth[i]);
+        }
+
+        wheelTotal.final += wheelErrors.final / SIM_RUNS;
+        wheelTotal.largest += wheelErrors.largest / SIM_RUNS;
+        imuTotal.final += imuErrors.final / SIM_RUNS;
+        imuTotal.largest += imuErrors.largest / SIM_RUNS;
+        ekfTotal.final += ekfErrors.final / SIM_RUNS;
+        ekfTotal.largest += ekfErrors.largest / SIM_RUNS;
+        ekfWorst = fmax(ekfWorst, ekfErrors.largest);
+    }
+
+    printf("%d runs of %ds, mean position error from the true path (in)\n\n", SIM_RUNS, SIM_DURATION);
+    printf("%-14s %12s %12s\n", "tracking", "at the end", "largest");
+    printf("%-14s %12.2f %12.2f\n", "wheels only", wheelTotal.final, wheelTotal.largest);
+    printf("%-14s %12.2f %12.2f\n", "IMU angle", imuTotal.final, imuTotal.largest);
+    printf("%-14s %12.2f %12.2f\n", "EKF", ekfTotal.final, ekfTotal.largest);
+    printf("largest EKF error in any run %.2fin (bound %d)\n\n", ekfWorst, EKF_BOUND);
+
+    // Time the step on a recording, restarting it when it runs out
+    Recording recording = record(1);
+    Odometry odometry(OdomGeometry{SIM_WHEELBASE, 0, SIM_TRACKING_WHEEL_DIAMETER});
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_STEPS; i++) {
+        size_t index = i % recording.samples.size();
+        if (index == 0) {
+            odometry.reset(0, 0, recording.start);
+        }
+        odometry.step(recording.samples[index]);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    sink = odometry.getPos().getX();
+    printf("%-24s %10.1f ns\n", "Odometry::step", elapsed.count() / BENCH_STEPS);
+
+    OdomEKF filter;
+    filter.reset(0, 0, 0);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_STEPS; i++) {
+        double t = i * SIM_PERIOD;
+        filter.filter(Vector2(0.01 * sin(t), 0.3), 0.01 * sin(0.7 * t), sin(0.7 * t), cos(0.7 * t), SIM_PERIOD);
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    sink = filter.getPos().getX();
+    printf("%-24s %10.1f ns\n", "OdomEKF::filter", elapsed.count() / BENCH_STEPS);
+
+    PlainOdometry wheels(false);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_STEPS; i++) {
+        wheels.step(recording.samples[i % recording.samples.size()]);
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    sink = wheels.getPos().getX();
+    printf("%-24s %10.1f ns\n", "wheels only step", elapsed.count() / BENCH_STEPS);
+
+    bool passed = ekfTotal.largest <= wheelTotal.largest && ekfTotal.largest <= imuTotal.largest * (1 + IMU_MARGIN) && ekfWorst <= EKF_BOUND;
+    printf("\n%s\n", passed ? "EKF tracks as well as the IMU angle and better than wheels only" : "FAIL EKF tracks worse than expected");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+/**
+ * \file fastTrigCheck.cpp
+ *
+ * \brief Sweeps fastSin, fastCos, fastSinCos and fastAtan2 against libm and checks the error bounds documented in fastTrig.h.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include tools/fastTrigCheck.cpp -o fastTrigCheck
+ *     ./fastTrigCheck
+ *
+ * sin and cos are checked at every step of SIN_STEP over |x| <= SIN_RANGE, and on both sides of
+ * every multiple of pi / 4 in that range where the range reduction switches quadrant. atan2 is
+ * checked at ATAN_ANGLES angles around the circle at each magnitude from 1e-3 to 1e3, and on both
+ * sides of every octant boundary where the reduction switches. Then the cost of each call is timed
+ * against libm. Exits with 1 if any error is over its bound.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include "fastTrig.h"
+
+/**
+ * Largest absolute error allowed for fastSin, fastCos and fastSinCos, the largest error of the
+ * sweep rounded up to 3 digits
+*/
+#define SIN_BOUND 2.68e-9
+
+/**
+ * Largest absolute error allowed for fastAtan2 in radians, the largest error of the sweep
+ * (8.0639e-9, at the edge of the polynomial's range) rounded up to 3 digits
+*/
+#define ATAN_BOUND 8.07e-9
+
+/**
+ * Largest angle swept for sin and cos in radians, far more than a heading reaches in a match
+*/
+#define SIN_RANGE 1000
+
+/**
+ * Step between angles swept for sin and cos in radians
+*/
+#define SIN_STEP 1e-5
+
+/**
+ * Number of angles swept around the circle at each atan2 magnitude
+*/
+#define ATAN_ANGLES 2000000
+
+/**
+ * Number of timed calls per function
+*/
+#define BENCH_CALLS 20000000
+
+/**
+ * Sink for results so the compiler can't remove the work being timed
+*/
+static volatile double sink;
+
+/**
+ * \brief Largest error found and where
+*/
+struct Worst {
+    double error = 0;
+    double x = 0, y = 0;
+
+    void check(double error, double x, double y = 0) {
+        if (error > this->error) {
+            this->error = error;
+            this->x = x;
+            this->y = y;
+        }
+    };
+};
+
+/**
+ * Check fastSin, fastCos and fastSinCos at an angle
+*/
+static void checkSin(double x, Worst& worst) {
+    double s, c;
+    fastSinCos(x, s, c);
+    double expectedS = sin(x), expectedC = cos(x);
+    worst.check(fmax(fabs(s - expectedS), fabs(c - expectedC)), x);
+    worst.check(fmax(fabs(fastSin(x) - expectedS), fabs(fastCos(x) - expectedC)), x);
+}
+
+/**
+ * Check fastAtan2 at a point
+*/
+static void checkAtan(double y, double x, Worst& worst) {
+    // Compare on the circle so -pi and pi count as the same angle
+    worst.check(fabs(remainder(fastAtan2(y, x) - atan2(y, x), 2 * M_PI)), x, y);
+}
+
+/**
+ * Time BENCH_CALLS calls of a function on angles across a few turns
+ * @return Nanoseconds per call
+*/
+template <typename Function>
+static double timeCalls(Function function) {
+    double total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_CALLS; i++) {
+        total += function(i * 1e-6 - 10);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    sink = total;
+    return elapsed.count() / BENCH_CALLS;
+}
+
+int main() {
+    // sin and cos over the whole range, then around every quadrant switch
+    Worst sinWorst;
+    long sinPoints = 0;
+    for (long i = -(long) (SIN_RANGE / SIN_STEP); i <= (long) (SIN_RANGE / SIN_STEP); i++) {
+        checkSin(i * SIN_STEP, sinWorst);
+        sinPoints++;
+    }
+    for (long k = -(long) (SIN_RANGE / M_PI_4); k <= (long) (SIN_RANGE / M_PI_4); k++) {
+        double boundary = k * M_PI_4;
+        double below = boundary, above = boundary;
+        for (int n = 0; n < 64; n++) {
+            below = nextafter(below, -INFINITY);
+            above = nextafter(above, INFINITY);
+            checkSin(below, sinWorst);
+            checkSin(above, sinWorst);
+            sinPoints += 2;
+        }
+        checkSin(boundary, sinWorst);
+        sinPoints++;
+    }
+
+    // atan2 around the circle at each magnitude, then around every octant boundary
+    Worst atanWorst;
+    long atanPoints = 0;
+    for (int exponent = -3; exponent <= 3; exponent++) {
+        double magnitude = pow(10, exponent);
+        for (int i = 0; i < ATAN_ANGLES; i++) {
+            double angle = 2 * M_PI * i / ATAN_ANGLES - M_PI;
+            checkAtan(magnitude * sin(angle), magnitude * cos(angle), atanWorst);
+            atanPoints++;
+        }
+        for (int octant = -4; octant <= 4; octant++) {
+            double angle = octant * M_PI_4;
+            double y = magnitude * sin(angle), x = magnitude * cos(angle);
+            for (int n = -64; n <= 64; n++) {
+                checkAtan(y + n * 1e-12 * magnitude, x, atanWorst);
+                checkAtan(y, x + n * 1e-12 * magnitude, atanWorst);
+                atanPoints += 2;
+            }
+        }
+        // tan(pi / 8), where the second reduction switches on
+        for (int n = -64; n <= 64; n++) {
+            double t = 0.4142135623730950 + n * 1e-16;
+            checkAtan(t * magnitude, magnitude, atanWorst);
+            atanPoints++;
+        }
+    }
+    checkAtan(0, 0, atanWorst);
+
+    bool sinPassed = sinWorst.error <= SIN_BOUND, atanPassed = atanWorst.error <= ATAN_BOUND;
+    printf("%-4s sin/cos %11ld points, largest error %.5g at x = %.9g (bound %.3g)\n",
+        sinPassed ? "ok" : "FAIL", sinPoints, sinWorst.error, sinWorst.x, SIN_BOUND);
+    printf("%-4s atan2   %11ld points, largest error %.5g at (%.6g, %.6g) (bound %.3g)\n\n",
+        atanPassed ? "ok" : "FAIL", atanPoints, atanWorst.error, atanWorst.x, atanWorst.y, ATAN_BOUND);
+
+    printf("%-12s %12s %12s\n", "function", "fast (ns)", "libm (ns)");
+    printf("%-12s %12.2f %12.2f\n", "sin", timeCalls([](double x) { return fastSin(x); }), timeCalls([](double x) { return sin(x); }));
+    printf("%-12s %12.2f %12.2f\n", "sincos", timeCalls([](double x) { double s, c; fastSinCos(x, s, c); return s + c; }),
+        timeCalls([](double x) { return sin(x) + cos(x); }));
+    printf("%-12s %12.2f %12.2f\n", "atan2", timeCalls([](double x) { return fastAtan2(x, 1.5); }),
+        timeCalls([](double x) { return atan2(x, 1.5); }));
+
+    return sinPassed && atanPassed ? 0 : 1;
+}
@@ -0,0 +1,331 @@
+/**
+ * \file headingCheck.cpp
+ *
+ * \brief Checks that the controllers agree with the heading Odometry publishes, by driving them from its output.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include -iquote include/tracking tools/headingCheck.cpp src/tracking/odometry.cpp \
+ *         src/tracking/odomEKF.cpp src/control/purePursuit.cpp src/control/ramsete.cpp src/control/trajectory.cpp \
+ *         src/control/splinePath.cpp src/control/relayTuner.cpp src/control/motionProfile.cpp src/control/profileFollower.cpp \
+ *         -o headingCheck
+ *     ./headingCheck
+ *
+ * The simulated robot only produces what the sensors would read: tracking wheel ticks and a
+ * clockwise positive IMU rotation. Everything the controllers see comes out of the same Odometry
+ * class the tracking task runs, so a controller that assumes the wrong heading convention spins
+ * or drives away from its target here the same way it would on the robot. Exits with 1 if any
+ * check fails.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include "control/purePursuit.h"
+#include "control/mpcTracker.h"
+#include "control/profileFollower.h"
+#include "control/ramsete.h"
+#include "control/relayTuner.h"
+#include "trackedRobot.h"
+
+/**
+ * Distance between the left and right wheels in inches, the same as WHEELBASE in chassis.h
+*/
+#define SIM_WHEELBASE 10.25
+
+/**
+ * Longest simulated motion in seconds
+*/
+#define SIM_TIMEOUT 10
+
+/**
+ * Longest relay tuning run in seconds, the same as TUNING_TIMEOUT in drivetrainPID.h
+*/
+#define SIM_TUNING_TIMEOUT 15
+
+static int failures = 0;
+
+/**
+ * Print a check's result and count it if it failed
+*/
+static void check(bool passed, const char* name, double value, const char* unit) {
+    printf("%-4s %-52s %9.3f%s\n", passed ? "ok" : "FAIL", name, value, unit);
+    if (!passed) {
+        failures++;
+    }
+}
+
+/**
+ * Drive to a point from the origin the way DrivetrainPID::runMoveToPoint does, turning to face it
+ * first and then steering towards it with proportional gains
+ * @return Distance from the point when stopped
+*/
+static double moveToPoint(Vector2 target) {
+    const double turnGain = 80, driveGain = 8;
+    TrackedRobot tracked(SensorRobot(SIM_WHEELBASE), SIM_WHEELBASE);
+
+    // Turn in place with positive output turning clockwise, like Drivetrain::rotate()
+    double targetHeading = (target - tracked.getPos()).getHeading();
+    while (tracked.robot.time < SIM_TIMEOUT / 2) {
+        double error = remainder(targetHeading - tracked.getHeading(), 2 * M_PI);
+        if (fabs(error) < 0.01) {
+            break;
+        }
+        double turn = fmax(-127, fmin(127, turnGain * error));
+        tracked.step(turn, -turn);
+    }
+
+    while (tracked.robot.time < SIM_TIMEOUT) {
+        Vector2 delta = target - tracked.getPos();
+        double distance = delta.getMagnitude();
+        if (distance < 0.5) {
+            break;
+        }
+
+        double vel = fmin(127, driveGain * distance);
+        double headingError = remainder(delta.getHeading() - tracked.getHeading(), 2 * M_PI);
+        double forward = vel * cos(headingError);
+        double turn = 0;
+        if (distance > 2) {
+            if (forward < 0) {
+                headingError = remainder(headingError + M_PI, 2 * M_PI);
+            }
+            turn = turnGain * headingError;
+        }
+
+        // Same as DrivetrainPID::driveArcade
+        double scale = fabs(forward) + fabs(turn) > 127 ? (127 - fmin(fabs(turn), 127)) / fabs(forward) : 1;
+        tracked.step(forward * scale + turn, forward * scale - turn);
+    }
+    for (int i = 0; i < 50; i++) {
+        tracked.step(0, 0);
+    }
+    return (target - tracked.robot.getPos()).getMagnitude();
+}
+
+/**
+ * Returns a ProfileFollower with the given gains, settling like src/globals/drivetrain.cpp
+ * (PIDInfo and SettleCriteria are filled in directly, their constructors live with the PROS code)
+*/
+static ProfileFollower follower(Feedforward feedforward, double p, double d, double errorBand, double velocityBand) {
+    PIDInfo constants;
+    constants.p = p;
+    constants.i = 0;
+    constants.d = d;
+
+    SettleCriteria criteria;
+    criteria.errorBand = errorBand;
+    criteria.velocityBand = velocityBand;
+    criteria.dwellTime = 0.1;
+    criteria.timeout = 1;
+    criteria.chainBand = 0;
+    return ProfileFollower(feedforward, constants, criteria);
+}
+
+/**
+ * Drive to a point from the origin the way ProfiledDrive::moveToPoint does, following a turn
+ * profile to face it and then a drive profile along the heading it faces, with the same settings
+ * as src/globals/drivetrain.cpp
+ * @return Distance from the point when stopped
+*/
+static double profiledMoveToPoint(Vector2 target) {
+    TrackedRobot tracked(SensorRobot(SIM_WHEELBASE), SIM_WHEELBASE);
+    ProfileFollower turnFollower = follower(Feedforward(5, 19, 2.85), 60, 4, M_PI / 180, M_PI / 18);
+    ProfileFollower driveFollower = follower(Feedforward(5, 3.7, 0.56), 8, 0.5, 0.5, 2);
+    MotionProfile profile;
+
+    // Turn the shortest way around, positive output turns clockwise like Drivetrain::rotate()
+    double start = tracked.getHeading();
+    profile.build(remainder((target - tracked.getPos()).getHeading() - start, 2 * M_PI), ProfileConstraints(4.5, 10, 60));
+    turnFollower.start(profile, start);
+    while (!turnFollower.isDone() && tracked.robot.time < SIM_TIMEOUT / 2) {
+        double output = turnFollower.step(tracked.getHeading(), SIM_DT);
+        tracked.step(output, -output);
+    }
+
+    // Drive the distance left, measuring progress along the heading it faces
+    Pose2 pose(tracked.getPos(), Rotation2::fromHeading(tracked.getHeading()));
+    Vector2 forward = pose.getRotation().rotate(Vector2(0, 1));
+    profile.build((target - pose.getTranslation()).getMagnitude(), ProfileConstraints(25, 40, 300));
+    driveFollower.start(profile, 0);
+    while (!driveFollower.isDone() && tracked.robot.time < SIM_TIMEOUT) {
+        double output = driveFollower.step((tracked.getPos() - pose.getTranslation()).dot(forward), SIM_DT);
+        tracked.step(output, output);
+    }
+    return (target - tracked.robot.getPos()).getMagnitude();
+}
+
+/**
+ * Follow a path with pure pursuit the way DrivetrainPID::runFollowPath does
+ * @param settings Pursuit settings
+ * @param time Set to the time in seconds following took
+ * @return Distance from the end of the path when done
+*/
+static double followPath(const std::vector<Vector2>& points, PursuitSettings settings, double& time) {
+    TrackedRobot tracked(SensorRobot(SIM_WHEELBASE), SIM_WHEELBASE);
+    PurePursuit pursuit(points.data(), points.size(), settings);
+    Vector2 last = tracked.getPos();
+    double speed = 0;
+    while (tracked.robot.time < SIM_TIMEOUT) {
+        Vector2 pos = tracked.getPos();
+        speed = (pos - last).getMagnitude() / SIM_DT;
+        last = pos;
+
+        PursuitTarget target = pursuit.step(pos, tracked.getHeading(), speed);
+        if (target.done) {
+            break;
+        }
+        double vel = pursuit.getSpeed(target);
+        double left = vel * (1 + target.curvature * SIM_WHEELBASE / 2);
+        double right = vel * (1 - target.curvature * SIM_WHEELBASE / 2);
+        double largest = fmax(fabs(left), fabs(right));
+        if (largest > 127) {
+            left *= 127 / largest;
+            right *= 127 / largest;
+        }
+        tracked.step(left, right);
+    }
+    time = tracked.robot.time;
+    return (points.back() - tracked.robot.getPos()).getMagnitude();
+}
+
+/**
+ * Follow a trajectory with a tracker the way DrivetrainPID::runFollowTrajectory does
+ * @param headingError Set to the difference between the tracked and planned heading at the end
+ * @return Distance from the end of the trajectory when done
+*/
+static double followTrajectory(const Trajectory& trajectory, TrajectoryTracker& tracker, double& headingError) {
+    TrackedRobot tracked(SensorRobot(SIM_WHEELBASE), SIM_WHEELBASE);
+    tracker.reset();
+    while (tracked.robot.time < trajectory.getDuration()) {
+        tracked.stepVelocity(tracker.step(trajectory, tracked.robot.time, tracked.getPos(), tracked.getHeading()));
+    }
+    for (int i = 0; i < 50; i++) {
+        tracked.step(0, 0);
+    }
+    TrajectoryState end = trajectory.sample(trajectory.getDuration());
+    headingError = remainder(tracked.getHeading() - end.heading, 2 * M_PI);
+    return (end.position - tracked.robot.getPos()).getMagnitude();
+}
+
+/**
+ * Run the relay tuner the way DrivetrainPID::tuneDrive does, measuring distance along the
+ * forward vector of the heading the robot starts at
+ * @param startDegrees Heading to start at in degrees
+ * @param travelled Set to the true distance driven along the robot's forward when done
+ * @return Whether the tuner finished before the timeout
+*/
+static bool tuneDrive(double startDegrees, double& travelled) {
+    SensorRobot robot(SIM_WHEELBASE);
+    robot.turnBy(startDegrees);
+    TrackedRobot tracked(robot, SIM_WHEELBASE);
+
+    Vector2 start = tracked.getPos();
+    double heading = tracked.getHeading();
+    Vector2 forward = Rotation2::fromHeading(heading).rotate(Vector2(0, 1));
+    RelayTuner tuner(12, 60, 0.1);
+    while (!tuner.isDone() && tracked.robot.time < SIM_TUNING_TIMEOUT) {
+        double output = tuner.step((tracked.getPos() - start).dot(forward), SIM_DT);
+        tracked.step(output, output);
+    }
+
+    // The robot drives straight, so its true forward doesn't change
+    Vector2 trueForward(sin(startDegrees * M_PI / 180), cos(startDegrees * M_PI / 180));
+    travelled = (tracked.robot.getPos() - start).dot(trueForward);
+    return tuner.isDone();
+}
+
+int main() {
+    // Open loop: drive straight, turn 90 degrees clockwise and drive straight again
+    TrackedRobot tracked(SensorRobot(SIM_WHEELBASE), SIM_WHEELBASE);
+    check(fabs(tracked.getHeading()) < 1e-9, "heading at the start is 0", tracked.getHeading(), " rad");
+    for (int i = 0; i < 100; i++) {
+        tracked.step(60, 60);
+    }
+    Vector2 moved = tracked.getPos();
+    check(moved.getY() > 10 && fabs(moved.getX()) < 0.01, "driving forward at heading 0 moves along +y", moved.getY(), " in");
+    check(fabs(moved.getHeading() - tracked.getHeading()) < 0.01, "Vector2::getHeading of the move matches", moved.getHeading(), " rad");
+
+    while (tracked.robot.read().imuRotation < 90) {
+        tracked.step(30, -30);
+    }
+    for (int i = 0; i < 50; i++) {
+        tracked.step(0, 0);
+    }
+    double heading = tracked.getHeading();
+    double imuHeading = tracked.robot.read().imuRotation * M_PI / 180;
+    check(imuHeading > M_PI / 2 && fabs(heading - imuHeading) < 0.01, "turning clockwise increases it with the IMU", heading, " rad");
+
+    Vector2 start = tracked.getPos();
+    for (int i = 0; i < 100; i++) {
+        tracked.step(60, 60);
+    }
+    moved = tracked.getPos() - start;
+    Vector2 forward = Rotation2::fromHeading(heading, cos(heading), sin(heading)).rotate(Vector2(0, 1));
+    check(moved.getX() > 10, "driving forward after the turn moves along +x", moved.getX(), " in");
+    check(moved.normalize().dot(forward) > 0.999, "Rotation2::fromHeading forward matches the move", moved.normalize().dot(forward), "");
+    double truthError = (tracked.getPos() - tracked.robot.getPos()).getMagnitude();
+    check(truthError < 0.5, "odometry matches the true position", truthError, " in");
+
+    // Closed loop: every controller only sees the odometry output
+    Vector2 targets[] = {Vector2(24, 24), Vector2(-24, 24), Vector2(24, -24), Vector2(-24, -24), Vector2(36, 0)};
+    for (Vector2 target : targets) {
+        char name[64];
+        snprintf(name, sizeof(name), "moveToPoint (%.0f, %.0f) stops on the point", target.getX(), target.getY());
+        double error = moveToPoint(target);
+        check(error < 1.5, name, error, " in");
+    }
+
+    for (Vector2 target : targets) {
+        char name[64];
+        snprintf(name, sizeof(name), "profiled moveToPoint (%.0f, %.0f) stops on the point", target.getX(), target.getY());
+        double error = profiledMoveToPoint(target);
+        check(error < 1.5, name, error, " in");
+    }
+
+    Waypoint route[] = {Waypoint(Vector2(0, 0), 0), Waypoint(Vector2(24, 36), M_PI / 2), Waypoint(Vector2(48, 36), M_PI / 2)};
+    SplinePath path(route, 3);
+    double followTime;
+    double error = followPath(path.getPoints(1), PursuitSettings(), followTime);
+    check(error < 3, "pure pursuit reaches the end of a right turn", error, " in");
+
+    // With an end tolerance it can't reach, the path should still end once the robot passes the end
+    PursuitSettings tight;
+    tight.endTolerance = 0.01;
+    error = followPath(path.getPoints(1), tight, followTime);
+    check(followTime < SIM_TIMEOUT && error < 3, "pure pursuit stops past the end of the path", followTime, " s");
+
+    // tuneDrive() has to measure along the way the robot drives, whichever way it faces
+    double startHeadings[] = {0, 90, 135, -60};
+    for (double startDegrees : startHeadings) {
+        char name[64];
+        double travelled;
+        snprintf(name, sizeof(name), "tuneDrive facing %.0f degrees oscillates around 12 in", startDegrees);
+        bool done = tuneDrive(startDegrees, travelled);
+        check(done && fabs(travelled - 12) < 3, name, travelled, " in");
+    }
+
+    // The planned heading should point the way the planned position moves
+    Trajectory trajectory(path.sampleEvenly(1), TrajectoryConstraints(0.9 * 127 * SIM_SPEED_GAIN, 60, SIM_WHEELBASE));
+    double worst = 0;
+    for (double t = 0.1; t < trajectory.getDuration() - 0.1; t += 0.1) {
+        TrajectoryState state = trajectory.sample(t);
+        double travel = (trajectory.sample(t + 0.01).position - trajectory.sample(t - 0.01).position).getHeading();
+        worst = fmax(worst, fabs(remainder(travel - state.heading, 2 * M_PI)));
+    }
+    check(worst < 0.05, "trajectory headings point along its motion", worst, " rad");
+
+    double headingError;
+    RamseteTracker ramsete(SIM_WHEELBASE);
+    error = followTrajectory(trajectory, ramsete, headingError);
+    check(error < 3, "RAMSETE reaches the end of a right turn", error, " in");
+    check(fabs(headingError) < 0.1, "RAMSETE ends at the planned heading", headingError, " rad");
+
+    MPCTracker<MPC_DEFAULT_HORIZON> mpc(SIM_WHEELBASE, 127 * SIM_SPEED_GAIN);
+    error = followTrajectory(trajectory, mpc, headingError);
+    check(error < 3, "MPC reaches the end of a right turn", error, " in");
+    check(fabs(headingError) < 0.1, "MPC ends at the planned heading", headingError, " rad");
+
+    printf("\n%s\n", failures == 0 ? "All checks passed" : "Some checks failed");
+    return failures == 0 ? 0 : 1;
+}
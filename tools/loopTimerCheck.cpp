@@ -0,0 +1,204 @@
+/**
+ * \file loopTimerCheck.cpp
+ *
+ * \brief Checks LoopTimer's schedule and statistics against a stubbed clock.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include tools/loopTimerCheck.cpp src/loopTimer.cpp -o loopTimerCheck
+ *     ./loopTimerCheck
+ *
+ * Links the real src/loopTimer.cpp, with pros::millis(), pros::micros() and
+ * pros::Task::delay_until() replaced by a simulated clock. delay_until() behaves like the FreeRTOS
+ * call under it: it sleeps until the previous wake time plus the period, or returns at once if that
+ * has passed, then moves the wake time on by one period. Every case runs loops with a known amount
+ * of work per iteration and checks the period, jitter and overrun statistics, and that the loop
+ * doesn't drift from its schedule the way pros::delay() after the work does. A last case reads the
+ * statistics while the loop sleeps in delay_until(), where another task like the display would
+ * run, and checks that every read comes from a single iteration. Exits with 1 if any case fails.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "loopTimer.h"
+#include "pros/rtos.hpp"
+
+/**
+ * Number of iterations run in each case
+*/
+#define CHECK_ITERATIONS 1000
+
+/**
+ * Simulated time in microseconds
+*/
+static uint64_t simMicros = 0;
+
+/**
+ * Largest time in microseconds that a task wakes up late by after delay_until(), 0 for none
+*/
+static uint32_t wakeLatency = 0;
+
+/**
+ * Timer whose statistics are read while it sleeps, standing in for another task, nullptr for none
+*/
+static LoopTimer* sleepingTimer = nullptr;
+
+/**
+ * Number of reads made while sleeping, and the number that mixed two iterations
+*/
+static long sleepReads = 0, mixedReads = 0;
+
+extern "C" uint64_t micros(void) {
+    return simMicros;
+}
+
+extern "C" uint32_t millis(void) {
+    return simMicros / 1000;
+}
+
+void pros::Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) {
+    // Every 10th iteration overruns from the 6th, so a read from a single iteration has one
+    // overrun per 10 iterations
+    if (sleepingTimer != nullptr) {
+        LoopStats stats = sleepingTimer->getStats();
+        sleepReads++;
+        if (stats.overruns != (stats.iterations + 4) / 10) {
+            mixedReads++;
+        }
+    }
+
+    uint64_t wake = (uint64_t) (*prev_time + delta) * 1000;
+    if (wake > simMicros) {
+        simMicros = wake;
+    }
+    if (wakeLatency > 0) {
+        simMicros += rand() % (wakeLatency + 1);
+    }
+    *prev_time += delta;
+}
+
+/**
+ * Number of failed checks
+*/
+static int failures = 0;
+
+/**
+ * Print a check and count it if it failed
+*/
+static void check(bool passed, const char* description, long value) {
+    printf("  %-4s %-44s %ld\n", passed ? "ok" : "FAIL", description, value);
+    if (!passed) {
+        failures++;
+    }
+}
+
+/**
+ * Run a loop for CHECK_ITERATIONS iterations
+ * @param timer The timer scheduling the loop
+ * @param work Returns the work done by an iteration in microseconds
+ * @return Simulated time the loop took in microseconds
+*/
+template <typename Work>
+static uint64_t runLoop(LoopTimer& timer, Work work) {
+    uint64_t start = simMicros;
+    timer.start();
+    for (int i = 0; i < CHECK_ITERATIONS; i++) {
+        simMicros += work(i);
+        timer.wait();
+    }
+    return simMicros - start;
+}
+
+int main() {
+    srand(1);
+
+    printf("fixed 3ms of work in a 10ms loop\n");
+    {
+        LoopTimer timer(10);
+        uint64_t elapsed = runLoop(timer, [](int) { return 3000; });
+        LoopStats stats = timer.getStats();
+        check(stats.iterations == CHECK_ITERATIONS, "iterations", stats.iterations);
+        check(stats.targetPeriod == 10000, "target period (us)", stats.targetPeriod);
+        check(stats.minPeriod == 10000 && stats.maxPeriod == 10000, "min and max period (us)", stats.maxPeriod);
+        check(stats.meanPeriod == 10000, "mean period (us)", stats.meanPeriod);
+        check(stats.maxJitter == 0, "max jitter (us)", stats.maxJitter);
+        check(stats.overruns == 0, "overruns", stats.overruns);
+        check(elapsed == CHECK_ITERATIONS * 10000ULL, "total time (us)", elapsed);
+    }
+
+    printf("1 to 9ms of work in a 10ms loop, against pros::delay(10) after the work\n");
+    {
+        LoopTimer timer(10);
+        uint64_t delayed = 0;
+        uint64_t elapsed = runLoop(timer, [&](int) {
+            uint32_t work = 1000 + rand() % 8001;
+            delayed += work + 10000;
+            return work;
+        });
+        LoopStats stats = timer.getStats();
+        check(stats.minPeriod == 10000 && stats.maxPeriod == 10000, "min and max period (us)", stats.maxPeriod);
+        check(stats.overruns == 0, "overruns", stats.overruns);
+        check(elapsed == CHECK_ITERATIONS * 10000ULL, "total time (us)", elapsed);
+        check(delayed > elapsed, "drift of pros::delay(10) over the run (us)", delayed - elapsed);
+    }
+
+    printf("13ms of work on every 10th iteration of a 10ms loop\n");
+    {
+        LoopTimer timer(10);
+        uint64_t elapsed = runLoop(timer, [](int i) { return i % 10 == 5 ? 13000 : 2000; });
+        LoopStats stats = timer.getStats();
+        check(stats.overruns == CHECK_ITERATIONS / 10, "overruns", stats.overruns);
+        check(stats.maxPeriod == 13000, "max period (us)", stats.maxPeriod);
+        check(stats.minPeriod == 7000, "min period, catching up (us)", stats.minPeriod);
+        check(stats.maxJitter == 3000, "max jitter (us)", stats.maxJitter);
+
+        // Every overrun is made up by the next iteration, so the schedule holds
+        check(stats.meanPeriod == 10000, "mean period (us)", stats.meanPeriod);
+        check(elapsed == CHECK_ITERATIONS * 10000ULL, "total time (us)", elapsed);
+    }
+
+    printf("up to 300us of wake up latency in a 5ms loop\n");
+    {
+        wakeLatency = 300;
+        LoopTimer timer(5);
+        uint64_t elapsed = runLoop(timer, [](int) { return 1000; });
+        LoopStats stats = timer.getStats();
+        wakeLatency = 0;
+        check(stats.maxJitter > 0 && stats.maxJitter <= 300, "max jitter (us)", stats.maxJitter);
+        check(stats.meanPeriod >= 4999 && stats.meanPeriod <= 5001, "mean period (us)", stats.meanPeriod);
+
+        // Latency doesn't build up, the loop ends no more than one latency behind schedule
+        check(elapsed <= CHECK_ITERATIONS * 5000ULL + 300, "total time (us)", elapsed);
+    }
+
+    printf("period changes\n");
+    {
+        LoopTimer timer(1);
+        check(timer.getPeriod() == LOOP_TIMER_MIN_PERIOD, "period of 1ms clamped to (ms)", timer.getPeriod());
+        timer.setPeriod(20);
+        check(timer.getPeriod() == 20, "period after setPeriod(20) (ms)", timer.getPeriod());
+
+        // After a period change, resetting the statistics measures the new period from scratch
+        runLoop(timer, [](int) { return 1000; });
+        timer.setPeriod(LOOP_TIMER_MIN_PERIOD);
+        timer.resetStats();
+        check(timer.getStats().iterations == 0, "iterations after resetStats()", timer.getStats().iterations);
+        runLoop(timer, [](int) { return 500; });
+        LoopStats stats = timer.getStats();
+        check(stats.meanPeriod == LOOP_TIMER_MIN_PERIOD * 1000, "mean period at the minimum period (us)", stats.meanPeriod);
+        check(stats.overruns == 0, "overruns at the minimum period", stats.overruns);
+    }
+
+    printf("statistics read while a 10ms loop with overruns sleeps\n");
+    {
+        LoopTimer timer(10);
+        sleepingTimer = &timer;
+        runLoop(timer, [](int i) { return i % 10 == 5 ? 13000 : 2000; });
+        sleepingTimer = nullptr;
+        check(sleepReads == CHECK_ITERATIONS, "reads while sleeping", sleepReads);
+        check(mixedReads == 0, "reads mixing two iterations", mixedReads);
+    }
+
+    printf("\n%s\n", failures == 0 ? "All checks passed" : "Some checks failed");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+/**
+ * \file mpcBench.cpp
+ *
+ * \brief Measures the time MPCTracker takes per step against its horizon length.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include tools/mpcBench.cpp src/control/trajectory.cpp src/control/splinePath.cpp -o mpcBench
+ *     ./mpcBench
+ *
+ * Steps trackers of several horizons along a trajectory from a pose a little off it, timing each
+ * solve with 1 and 2 iterations. Tracking error is compared with the other controllers in
+ * tools/trackerSim.cpp.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include "control/mpcTracker.h"
+
+/**
+ * Distance between the left and right wheels in inches, the same as WHEELBASE in chassis.h
+*/
+#define SIM_WHEELBASE 10.25
+
+/**
+ * Top wheel velocity in inches per second, a 200 rpm drive on 3.25" wheels
+*/
+#define SIM_MAX_VELOCITY 34
+
+/**
+ * Number of steps timed for each horizon
+*/
+#define BENCH_STEPS 5000
+
+/**
+ * Sink for results so the compiler can't remove the work being timed
+*/
+static volatile double sink;
+
+/**
+ * Time the steps of a tracker along a trajectory, 10 ms apart like the motion task
+ * @return Microseconds per step
+*/
+template <int N>
+static double timeSolve(const Trajectory& trajectory, int iterations) {
+    MPCSettings settings;
+    settings.iterations = iterations;
+    MPCTracker<N> tracker(SIM_WHEELBASE, SIM_MAX_VELOCITY, settings);
+
+    double total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_STEPS; i++) {
+        double t = fmod(i * 0.01, trajectory.getDuration());
+        if (t < 0.01) {
+            tracker.reset();
+        }
+
+        // Sit a little off the trajectory so every solve has something to correct
+        TrajectoryState state = trajectory.sample(t);
+        Vector2 position = state.position + Vector2(1, -0.5);
+        WheelVelocities wheels = tracker.step(trajectory, t, position, state.heading + 0.05);
+        total += wheels.left + wheels.right;
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    sink = total;
+    return elapsed.count() / BENCH_STEPS;
+}
+
+int main() {
+    Waypoint route[] = {Waypoint(Vector2(0, 0), 0), Waypoint(Vector2(18, 24), 0), Waypoint(Vector2(0, 48), 0),
+        Waypoint(Vector2(18, 72), 0), Waypoint(Vector2(0, 96), 0)};
+    SplinePath path(route, 5);
+    Trajectory trajectory(path.sampleEvenly(1), TrajectoryConstraints(0.9 * SIM_MAX_VELOCITY, 60, SIM_WHEELBASE));
+
+    printf("%-8s %9s %14s %14s\n", "horizon", "preview", "1 iter (us)", "2 iter (us)");
+    printf("%-8d %8.2fs %14.2f %14.2f\n", 5, 5 * MPCSettings().stepTime, timeSolve<5>(trajectory, 1), timeSolve<5>(trajectory, 2));
+    printf("%-8d %8.2fs %14.2f %14.2f\n", 10, 10 * MPCSettings().stepTime, timeSolve<10>(trajectory, 1), timeSolve<10>(trajectory, 2));
+    printf("%-8d %8.2fs %14.2f %14.2f\n", 15, 15 * MPCSettings().stepTime, timeSolve<15>(trajectory, 1), timeSolve<15>(trajectory, 2));
+    printf("%-8d %8.2fs %14.2f %14.2f\n", 20, 20 * MPCSettings().stepTime, timeSolve<20>(trajectory, 1), timeSolve<20>(trajectory, 2));
+    printf("%-8d %8.2fs %14.2f %14.2f\n", 30, 30 * MPCSettings().stepTime, timeSolve<30>(trajectory, 1), timeSolve<30>(trajectory, 2));
+    return 0;
+}
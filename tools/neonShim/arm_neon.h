@@ -0,0 +1,79 @@
+/**
+ * \file arm_neon.h
+ *
+ * \brief Plain C++ stand in for the NEON intrinsics used by src/tracking/batchTransform.cpp and include/control/pidBank.h.
+ *
+ * Only for running the NEON code paths on a computer without an ARM toolchain (see
+ * tools/batchTransformCheck.cpp and tools/pidBankCheck.cpp). Each intrinsic does the same per lane math as the real one,
+ * rounding after every multiply like the V5's non-fused vmla and vmls, but nothing is vectorized,
+ * so timings taken with it say nothing about the V5.
+*/
+
+#pragma once
+
+/**
+ * \brief 4 floats, one per lane
+*/
+struct float32x4_t {
+    float lane[4];
+};
+
+inline float32x4_t vdupq_n_f32(float value) {
+    return float32x4_t{{value, value, value, value}};
+}
+
+inline float32x4_t vld1q_f32(const float* ptr) {
+    return float32x4_t{{ptr[0], ptr[1], ptr[2], ptr[3]}};
+}
+
+inline void vst1q_f32(float* ptr, float32x4_t a) {
+    for (int i = 0; i < 4; i++) ptr[i] = a.lane[i];
+}
+
+inline float32x4_t vaddq_f32(float32x4_t a, float32x4_t b) {
+    for (int i = 0; i < 4; i++) a.lane[i] += b.lane[i];
+    return a;
+}
+
+inline float32x4_t vsubq_f32(float32x4_t a, float32x4_t b) {
+    for (int i = 0; i < 4; i++) a.lane[i] -= b.lane[i];
+    return a;
+}
+
+inline float32x4_t vmulq_f32(float32x4_t a, float32x4_t b) {
+    for (int i = 0; i < 4; i++) a.lane[i] *= b.lane[i];
+    return a;
+}
+
+// a + b * c
+inline float32x4_t vmlaq_f32(float32x4_t a, float32x4_t b, float32x4_t c) {
+    for (int i = 0; i < 4; i++) {
+        volatile float product = b.lane[i] * c.lane[i];
+        a.lane[i] += product;
+    }
+    return a;
+}
+
+// a - b * c
+inline float32x4_t vmlsq_f32(float32x4_t a, float32x4_t b, float32x4_t c) {
+    for (int i = 0; i < 4; i++) {
+        volatile float product = b.lane[i] * c.lane[i];
+        a.lane[i] -= product;
+    }
+    return a;
+}
+
+inline float32x4_t vnegq_f32(float32x4_t a) {
+    for (int i = 0; i < 4; i++) a.lane[i] = -a.lane[i];
+    return a;
+}
+
+inline float32x4_t vminq_f32(float32x4_t a, float32x4_t b) {
+    for (int i = 0; i < 4; i++) a.lane[i] = b.lane[i] < a.lane[i] ? b.lane[i] : a.lane[i];
+    return a;
+}
+
+inline float32x4_t vmaxq_f32(float32x4_t a, float32x4_t b) {
+    for (int i = 0; i < 4; i++) a.lane[i] = b.lane[i] > a.lane[i] ? b.lane[i] : a.lane[i];
+    return a;
+}
@@ -0,0 +1,181 @@
+/**
+ * \file odomDriftCheck.cpp
+ *
+ * \brief Compares odometry drift from accumulating float inches against accumulating integer ticks at several loop rates.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include tools/odomDriftCheck.cpp src/tracking/odometry.cpp src/tracking/odomEKF.cpp -o odomDriftCheck
+ *     ./odomDriftCheck
+ *
+ * Simulates 60 seconds of driving with quantized tracking wheel encoders and runs the wheel
+ * odometry math three ways on the same ticks: the old float path that summed inch deltas in
+ * floats, the integer path that sums ticks in 64 bit integers and converts to inches in double
+ * (as Odometry does), and a long double reference of the integer path. Drift is the difference
+ * from the reference, so encoder quantization, which all three share, doesn't count. The
+ * integer path's tick totals are also checked against the real Odometry class fed the same
+ * samples. Exits with 1 if the integer path drifts by more than 1e-6 in or rad at any rate,
+ * which is what lets LOOP_TIMER_MIN_PERIOD go down to 2 ms.
+*/
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "tracking/odometry.h"
+
+/**
+ * Distance between the left and right tracking wheels in inches, the same as WHEELBASE in chassis.h
+*/
+#define SIM_WHEELBASE 10.25
+
+/**
+ * Diameter of the tracking wheels in inches, the same as TRACKING_WHEEL_DIAMETER in chassis.h
+*/
+#define SIM_TRACKING_WHEEL_DIAMETER 2.75
+
+/**
+ * Length of the simulated run in seconds, about a skills run
+*/
+#define SIM_DURATION 60
+
+/**
+ * Largest drift allowed for the integer path, in inches or radians
+*/
+#define INTEGER_TOLERANCE 1e-6
+
+/**
+ * \brief Wheel odometry that sums inch deltas in Real, like Odometry did before it kept ticks
+ *
+ * The position is summed in at least double, like the filter's state.
+*/
+template <typename Real>
+class InchOdometry {
+    public:
+        void step(int32_t lDelta, int32_t rDelta) {
+            const Real degreeToInch = M_PI * SIM_TRACKING_WHEEL_DIAMETER / 360;
+            Real lDist = lDelta * degreeToInch;
+            Real rDist = rDelta * degreeToInch;
+            this->left += lDist;
+            this->right += rDist;
+
+            Real prevAngle = this->angle;
+            this->angle = (this->right - this->left) / (Real) SIM_WHEELBASE;
+            this->integrate(lDist, rDist, prevAngle, this->angle - prevAngle);
+        };
+
+        typedef decltype(Real() + 0.0) Position;
+        Position x = 0, y = 0;
+        Real angle = 0;
+
+    protected:
+        /**
+         * Move along the chord of the arc since the last step, rotated by the average angle
+        */
+        void integrate(Real lDist, Real rDist, Real prevAngle, Real aDelta) {
+            Real localX = 0, localY = (lDist + rDist) / 2;
+            if (aDelta != 0) {
+                Real chordScale = 2 * sin(aDelta / 2);
+                localY = chordScale * (rDist / aDelta - (Real) SIM_WHEELBASE / 2);
+            }
+            Position average = prevAngle + aDelta / 2;
+            this->x += localX * cos(average) - localY * sin(average);
+            this->y += localX * sin(average) + localY * cos(average);
+        };
+
+        Real left = 0, right = 0;
+};
+
+/**
+ * \brief Wheel odometry that sums ticks in 64 bit integers and converts them to inches in Real, like Odometry
+*/
+template <typename Real>
+class TickOdometry : public InchOdometry<Real> {
+    public:
+        void step(int32_t lDelta, int32_t rDelta) {
+            const Real degreeToInch = M_PI * SIM_TRACKING_WHEEL_DIAMETER / 360;
+            this->leftTicks += lDelta;
+            this->rightTicks += rDelta;
+
+            Real prevAngle = this->angle;
+            this->angle = (this->rightTicks - this->leftTicks) * degreeToInch / (Real) SIM_WHEELBASE;
+            this->integrate(lDelta * degreeToInch, rDelta * degreeToInch, prevAngle, this->angle - prevAngle);
+        };
+
+        int64_t leftTicks = 0, rightTicks = 0;
+};
+
+/**
+ * \brief Drift of one run from the reference
+*/
+struct Drift {
+    double position = 0; // Inches
+    double angle = 0; // Radians
+};
+
+/**
+ * Drive for SIM_DURATION at a loop period, feeding every variant the same encoder ticks
+ * @param periodMs Loop period in milliseconds
+ * @param tickMismatch Set to the largest difference between the integer path's tick totals and Odometry's in inches
+*/
+static void run(int periodMs, Drift& floatDrift, Drift& integerDrift, double& tickMismatch) {
+    const double inchPerTick = M_PI * SIM_TRACKING_WHEEL_DIAMETER / 360;
+    const double dt = periodMs / 1000.0;
+
+    InchOdometry<float> floatPath;
+    TickOdometry<double> integerPath;
+    TickOdometry<long double> reference;
+    Odometry odometry(OdomGeometry{SIM_WHEELBASE, 0, SIM_TRACKING_WHEEL_DIAMETER});
+    odometry.reset(0, 0, SensorSample{0, 0, 0, 0, 0, 0});
+
+    double leftDistance = 0, rightDistance = 0;
+    int32_t lastLeft = 0, lastRight = 0;
+    tickMismatch = 0;
+    for (int step = 1; step * dt <= SIM_DURATION; step++) {
+        // Weave at around 30 in/s, the sides drifting in and out of phase
+        double t = step * dt;
+        leftDistance += (30 + 10 * sin(0.5 * t)) * dt;
+        rightDistance += (30 + 10 * sin(0.5 * t + 1)) * dt;
+
+        int32_t left = (int32_t) floor(leftDistance / inchPerTick);
+        int32_t right = (int32_t) floor(rightDistance / inchPerTick);
+        floatPath.step(left - lastLeft, right - lastRight);
+        integerPath.step(left - lastLeft, right - lastRight);
+        reference.step(left - lastLeft, right - lastRight);
+        lastLeft = left;
+        lastRight = right;
+
+        odometry.step(SensorSample{(uint32_t) (t * 1000000), left, right, 0, 0, 0});
+        tickMismatch = fmax(tickMismatch, fmax(fabs(odometry.getLeftDistance() - integerPath.leftTicks * inchPerTick),
+            fabs(odometry.getRightDistance() - integerPath.rightTicks * inchPerTick)));
+    }
+
+    floatDrift.position = hypot(floatPath.x - reference.x, floatPath.y - reference.y);
+    floatDrift.angle = fabs(floatPath.angle - reference.angle);
+    integerDrift.position = hypot(integerPath.x - reference.x, integerPath.y - reference.y);
+    integerDrift.angle = fabs(integerPath.angle - reference.angle);
+}
+
+int main() {
+    const int periods[] = {10, 5, 2, 1};
+    bool passed = true;
+
+    printf("%ds run at ~30 in/s, drift from a long double reference on the same ticks\n\n", SIM_DURATION);
+    printf("%-8s %16s %16s %16s %16s\n", "period", "float pos (in)", "float angle", "integer pos (in)", "integer angle");
+    for (int period : periods) {
+        Drift floatDrift, integerDrift;
+        double tickMismatch;
+        run(period, floatDrift, integerDrift, tickMismatch);
+        char label[16];
+        snprintf(label, sizeof(label), "%dms", period);
+        printf("%-8s %16.3g %16.3g %16.3g %16.3g\n", label, floatDrift.position, floatDrift.angle,
+            integerDrift.position, integerDrift.angle);
+
+        if (integerDrift.position > INTEGER_TOLERANCE || integerDrift.angle > INTEGER_TOLERANCE || tickMismatch > 0) {
+            printf("FAIL integer path drifted, or Odometry's tick totals differ by %.3g in\n", tickMismatch);
+            passed = false;
+        }
+    }
+
+    printf("\n%s\n", passed ? "Integer path holds at every rate" : "Integer path drifted");
+    return passed ? 0 : 1;
+}
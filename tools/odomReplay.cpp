@@ -0,0 +1,114 @@
+/**
+ * \file odomReplay.cpp
+ * 
+ * \brief Replays odometry recordings off the robot through the same Odometry class used by the tracking task.
+ * 
+ * Recordings are made on the robot with startTrackingRecording(). Copy them off the SD card and run:
+ * 
+ *     g++ -O2 -std=gnu++17 -iquote include -iquote include/tracking tools/odomReplay.cpp \
+ *         src/tracking/odometry.cpp src/tracking/odomEKF.cpp -o odomReplay
+ *     ./odomReplay [--wheelbase in] [--back-offset in] [--wheel-diameter in] recording.bin...
+ * 
+ * Geometry options override the values stored in each recording, which makes it easy to
+ * check the effect of a change to chassis.h across many recordings at once.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "tracking/odometry.h"
+
+/**
+ * Replay a single recording
+ * @param path The recording file
+ * @param geometry Geometry overrides, any value that isn't positive is taken from the recording
+ * @param samples Incremented by the number of samples replayed
+ * @return False if the file is not a valid recording
+*/
+static bool replay(const char* path, OdomGeometry geometry, long& samples) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "%s: could not open file\n", path);
+        return false;
+    }
+
+    RecordingHeader header;
+    if (fread(&header, sizeof(RecordingHeader), 1, file) != 1
+        || memcmp(header.magic, RECORDING_MAGIC, sizeof(header.magic)) != 0
+        || header.version != RECORDING_VERSION
+        || header.sampleSize != sizeof(SensorSample)) {
+        fprintf(stderr, "%s: not a version %d recording\n", path, RECORDING_VERSION);
+        fclose(file);
+        return false;
+    }
+
+    // Load all samples up front so the replay itself isn't limited by disk reads
+    std::vector<SensorSample> recording;
+    SensorSample buffer[1024];
+    size_t read;
+    while ((read = fread(buffer, sizeof(SensorSample), 1024, file)) > 0) {
+        recording.insert(recording.end(), buffer, buffer + read);
+    }
+    fclose(file);
+
+    // Use the recorded geometry for anything not overridden
+    if (geometry.wheelbase <= 0) geometry.wheelbase = header.geometry.wheelbase;
+    if (geometry.backWheelOffset <= 0) geometry.backWheelOffset = header.geometry.backWheelOffset;
+    if (geometry.trackingWheelDiameter <= 0) geometry.trackingWheelDiameter = header.geometry.trackingWheelDiameter;
+
+    Odometry odometry(geometry);
+    odometry.reset(header.startX, header.startY, header.start);
+    for (const SensorSample& sample : recording) {
+        odometry.step(sample);
+    }
+    samples += recording.size();
+
+    double duration = recording.empty() ? 0 : (uint32_t) (recording.back().timestamp - header.start.timestamp) / 1000000.0;
+    printf("%s: %zu samples, %.1fs, x %.3f, y %.3f, heading %.2f deg\n",
+        path,
+        recording.size(),
+        duration,
+        odometry.getPos().getX(),
+        odometry.getPos().getY(),
+        odometry.getHeading() * 180 / M_PI
+    );
+    return true;
+}
+
+int main(int argc, char** argv) {
+    OdomGeometry geometry = {0, 0, 0};
+    std::vector<const char*> paths;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--wheelbase") == 0 && i + 1 < argc) {
+            geometry.wheelbase = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--back-offset") == 0 && i + 1 < argc) {
+            geometry.backWheelOffset = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--wheel-diameter") == 0 && i + 1 < argc) {
+            geometry.trackingWheelDiameter = atof(argv[++i]);
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+
+    if (paths.empty()) {
+        fprintf(stderr, "Usage: %s [--wheelbase in] [--back-offset in] [--wheel-diameter in] recording.bin...\n", argv[0]);
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    long samples = 0;
+    int failed = 0;
+    for (const char* path : paths) {
+        if (!replay(path, geometry, samples)) {
+            failed++;
+        }
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("Replayed %ld samples from %zu recordings in %.3fs\n", samples, paths.size() - failed, elapsed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,245 @@
+/**
+ * \file pidBankCheck.cpp
+ *
+ * \brief Checks PIDBank's outputs against its scalar path and PIDController, and compares the cost of stepping 16 controllers.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include -iquote include/control tools/pidBankCheck.cpp src/control/PID.cpp -o pidBankCheck
+ *     ./pidBankCheck
+ *
+ * The NEON path can be run on a computer without an ARM toolchain through the stand in intrinsics
+ * in tools/neonShim by adding -D__ARM_NEON -I tools/neonShim, which checks its lane handling and
+ * left over controllers but not the real instructions, and makes its timings meaningless. With the
+ * PROS toolchain it can be built with the flags in common.mk and run on the V5 or under qemu-arm.
+ *
+ * Banks of every size up to 16 are stepped through random targets, sensor values, gains and limits,
+ * comparing step() with stepScalar(). Then a bank with no limits is compared with PIDControllers
+ * given the same gains and time steps, which run in double. Exits with 1 if any output differs by
+ * more than the tolerance.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "control/pidBank.h"
+
+/**
+ * Number of controllers in the bank, one per motor on a full V5
+*/
+#define BANK_SIZE 16
+
+/**
+ * Largest allowed difference between step() and stepScalar(). Both do the same float operations
+ * in the same order, so this only allows for the last bit of rounding
+*/
+#define SCALAR_TOLERANCE 1e-5
+
+/**
+ * Largest allowed difference from PIDController as a fraction of its output, a few float epsilons
+ * over the accumulated steps
+*/
+#define CONTROLLER_TOLERANCE 1e-4
+
+/**
+ * Number of steps run in each check
+*/
+#define CHECK_STEPS 500
+
+/**
+ * Number of timed steps of all BANK_SIZE controllers
+*/
+#define BENCH_STEPS 200000
+
+/**
+ * Sink for results so the compiler can't remove the work being timed
+*/
+static volatile double sink;
+
+/**
+ * PIDController::step(double) reads pros::micros(), only step(double, double) is used here
+*/
+extern "C" uint64_t micros(void) {
+    return 0;
+}
+
+/**
+ * Returns a random value in range [low, high]
+*/
+static double random(double low, double high) {
+    return low + (high - low) * rand() / RAND_MAX;
+}
+
+/**
+ * Returns random gains like the drive and turn controllers use
+*/
+static PIDInfo randomGains() {
+    PIDInfo constants;
+    constants.p = random(0.5, 10);
+    constants.i = random(0, 2);
+    constants.d = random(0, 1);
+    return constants;
+}
+
+/**
+ * Step a bank of count controllers with step() and a copy with stepScalar() through random inputs
+ * @return The largest difference between their outputs
+*/
+template <int N>
+static double compareScalar(int count) {
+    PIDBank<N> bank, scalar;
+    typename PIDBank<N>::Handle handles[N], scalarHandles[N];
+    for (int i = 0; i < count; i++) {
+        PIDInfo constants = randomGains();
+        handles[i] = bank.add(constants);
+        scalarHandles[i] = scalar.add(constants);
+
+        // Low enough limits that both clamps are hit
+        float outputLimit = random(20, 127), integralLimit = random(1, 20);
+        handles[i].setLimits(outputLimit, integralLimit);
+        scalarHandles[i].setLimits(outputLimit, integralLimit);
+    }
+
+    double largest = 0;
+    for (int s = 0; s < CHECK_STEPS; s++) {
+        float dt = random(0.005, 0.02);
+        for (int i = 0; i < count; i++) {
+            float target = random(-50, 50), sense = random(-50, 50);
+            handles[i].setTarget(target);
+            handles[i].setSense(sense);
+            scalarHandles[i].setTarget(target);
+            scalarHandles[i].setSense(sense);
+        }
+        bank.step(dt);
+        scalar.stepScalar(dt);
+
+        for (int i = 0; i < count; i++) {
+            largest = fmax(largest, fabs(handles[i].getOutput() - scalarHandles[i].getOutput()));
+        }
+    }
+    return largest;
+}
+
+/**
+ * Step a bank with no limits and PIDControllers with the same gains towards moving targets
+ * @return The largest difference between their outputs as a fraction of the PIDController's output
+*/
+static double compareController() {
+    PIDBank<BANK_SIZE> bank;
+    PIDBank<BANK_SIZE>::Handle handles[BANK_SIZE];
+    PIDController* controllers[BANK_SIZE];
+    for (int i = 0; i < BANK_SIZE; i++) {
+        PIDInfo constants = randomGains();
+        handles[i] = bank.add(constants);
+        handles[i].setLimits(1e30f, 1e30f);
+
+        // Settling off so the output is never zeroed, and the integral always on
+        SettleCriteria criteria;
+        criteria.errorBand = -1;
+        criteria.velocityBand = INFINITY;
+        criteria.dwellTime = DEFAULT_SETTLE_DWELL;
+        criteria.timeout = 0;
+        criteria.chainBand = 0;
+        controllers[i] = new PIDController(0, constants, criteria, INFINITY);
+    }
+
+    double largest = 0;
+    double expected[BANK_SIZE];
+    for (int s = 0; s < CHECK_STEPS; s++) {
+        float dt = 0.01;
+        for (int i = 0; i < BANK_SIZE; i++) {
+            float target = 20 * sin(0.01 * s + i), sense = 20 * sin(0.01 * s + i - 0.3);
+            handles[i].setTarget(target);
+            handles[i].setSense(sense);
+            controllers[i]->target = target;
+            expected[i] = controllers[i]->step(sense, dt);
+        }
+        bank.step(dt);
+
+        for (int i = 0; i < BANK_SIZE; i++) {
+            largest = fmax(largest, fabs(handles[i].getOutput() - expected[i]) / fmax(1, fabs(expected[i])));
+        }
+    }
+
+    for (int i = 0; i < BANK_SIZE; i++) {
+        delete controllers[i];
+    }
+    return largest;
+}
+
+/**
+ * Time BENCH_STEPS steps of all BANK_SIZE controllers
+ * @return Nanoseconds per step of all the controllers
+*/
+template <typename Step>
+static double timeSteps(Step step) {
+    auto start = std::chrono::steady_clock::now();
+    double total = 0;
+    for (int s = 0; s < BENCH_STEPS; s++) {
+        total += step(s);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    sink = total;
+    return elapsed.count() / BENCH_STEPS;
+}
+
+int main() {
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    printf("PIDBank::step() uses the NEON path\n\n");
+#else
+    printf("PIDBank::step() uses the scalar path\n\n");
+#endif
+
+    // Every size up to the bank size exercises the left over controllers
+    srand(1);
+    double scalarError = 0;
+    for (int count = 1; count <= BANK_SIZE; count++) {
+        scalarError = fmax(scalarError, compareScalar<BANK_SIZE>(count));
+    }
+    double controllerError = compareController();
+
+    bool passed = scalarError <= SCALAR_TOLERANCE && controllerError <= CONTROLLER_TOLERANCE;
+    printf("%-4s largest difference from stepScalar()  %.3g (tolerance %.0e)\n",
+        scalarError <= SCALAR_TOLERANCE ? "ok" : "FAIL", scalarError, SCALAR_TOLERANCE);
+    printf("%-4s largest difference from PIDController %.3g of its output (tolerance %.0e)\n\n",
+        controllerError <= CONTROLLER_TOLERANCE ? "ok" : "FAIL", controllerError, CONTROLLER_TOLERANCE);
+
+    // Time one step of 16 controllers each way
+    PIDBank<BANK_SIZE> bank;
+    PIDBank<BANK_SIZE>::Handle handles[BANK_SIZE];
+    PIDController* controllers[BANK_SIZE];
+    for (int i = 0; i < BANK_SIZE; i++) {
+        PIDInfo constants = randomGains();
+        handles[i] = bank.add(constants);
+        controllers[i] = new PIDController(0, constants, SettleCriteria(1), 10);
+    }
+
+    printf("%-28s %14s\n", "16 controllers", "ns per step");
+    printf("%-28s %14.1f\n", "PIDBank::step", timeSteps([&](int s) {
+        for (int i = 0; i < BANK_SIZE; i++) {
+            handles[i].setSense(s % 100 + i);
+        }
+        bank.step(0.01f);
+        return handles[s % BANK_SIZE].getOutput();
+    }));
+    printf("%-28s %14.1f\n", "PIDBank::stepScalar", timeSteps([&](int s) {
+        for (int i = 0; i < BANK_SIZE; i++) {
+            handles[i].setSense(s % 100 + i);
+        }
+        bank.stepScalar(0.01f);
+        return handles[s % BANK_SIZE].getOutput();
+    }));
+    printf("%-28s %14.1f\n", "PIDController::step x16", timeSteps([&](int s) {
+        double total = 0;
+        for (int i = 0; i < BANK_SIZE; i++) {
+            total += controllers[i]->step(s % 100 + i, 0.01);
+        }
+        return total;
+    }));
+
+    for (int i = 0; i < BANK_SIZE; i++) {
+        delete controllers[i];
+    }
+    return passed ? 0 : 1;
+}
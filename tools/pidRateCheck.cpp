@@ -0,0 +1,216 @@
+/**
+ * \file pidRateCheck.cpp
+ *
+ * \brief Checks that the same PID gains give the same response on a simulated drivetrain at different loop rates.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include -iquote include/control tools/pidRateCheck.cpp src/control/PID.cpp -o pidRateCheck
+ *     ./pidRateCheck
+ *
+ * The plant is simulated in 1ms steps, and a controller steps every 5, 10 or 20ms or at random
+ * intervals from 2 to 18ms like a loop with no delay, holding its output in between. Each drives
+ * the plant through a 24 inch move with one set of gains per second. PIDController::step(sense, dt)
+ * at every rate is compared with its response at 10ms, and PID<>::step(sense, dt) with
+ * PIDController at the same rate. The same gains turned into per step gains at 10ms and stepped
+ * with dt = 1, the way PIDController used to work, are run alongside to show what the time step
+ * fixes. Exits with 1 if any check fails.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Plant step in seconds, finer than any of the loop rates
+*/
+#define SIM_DT 0.001
+
+#include "plantModel.h"
+#include "control/policyPID.h"
+
+/**
+ * Length of each move in seconds
+*/
+#define SIM_TIME 4.0
+
+/**
+ * Number of plant steps in each move
+*/
+#define SIM_STEPS ((int) (SIM_TIME / SIM_DT))
+
+/**
+ * Distance of each move in inches
+*/
+#define MOVE_DISTANCE 24
+
+/**
+ * Distance from the target in inches that counts as settled
+*/
+#define SETTLE_BAND 0.5
+
+/**
+ * Period in seconds the per step gains are worked out for
+*/
+#define TUNED_PERIOD 0.01
+
+/**
+ * Largest allowed distance in inches between a response and the response at 10ms at any time
+*/
+#define CURVE_BOUND 0.1
+
+/**
+ * Largest allowed difference in seconds between a settle time and the settle time at 10ms
+*/
+#define SETTLE_BOUND 0.02
+
+/**
+ * Largest allowed difference in inches between PID<> and PIDController at the same rate
+*/
+#define TEMPLATE_BOUND 1e-9
+
+/**
+ * Gains per second, for the drive loop of a 200rpm drivetrain
+*/
+static const PIDInfo gains(8, 0.2, 0.6);
+
+/**
+ * PIDController::step(double) reads pros::micros(), only step(double, double) is used here
+*/
+extern "C" uint64_t micros(void) {
+    return 0;
+}
+
+/**
+ * \brief Position of the plant at every step of a move, and how the move went
+*/
+struct Response {
+    double position[SIM_STEPS];
+    double overshoot = 0;
+    double settleTime = 0;
+};
+
+/**
+ * Returns a PIDController with gains that never settles or drops the integral, so its output only
+ * depends on the gains and time steps
+*/
+static PIDController makeController(PIDInfo constants) {
+    SettleCriteria criteria;
+    criteria.errorBand = -1;
+    criteria.velocityBand = INFINITY;
+    criteria.dwellTime = DEFAULT_SETTLE_DWELL;
+    criteria.timeout = 0;
+    criteria.chainBand = 0;
+    return PIDController(MOVE_DISTANCE, constants, criteria, INFINITY);
+}
+
+/**
+ * Drive the plant through a move with a controller stepped at an interval
+ * @param step Returns the output for a position and the time since the last step in seconds
+ * @param period Time between steps in ms, 0 for random intervals from 2 to 18ms
+ * @param response Filled with the plant's response
+*/
+template <typename Step>
+static void runMove(Step step, int period, Response& response) {
+    Plant plant(0.27, 0.08, 0.02);
+    srand(1);
+    int nextStep = 0, lastStep = 0;
+    double output = 0;
+    response.settleTime = 0;
+    response.overshoot = 0;
+    for (int i = 0; i < SIM_STEPS; i++) {
+        // Hold the output between controller steps
+        if (i == nextStep) {
+            output = step(plant.getPosition(), (i - lastStep) * SIM_DT);
+            lastStep = i;
+            nextStep = i + (period > 0 ? period : 2 + rand() % 17);
+        }
+        double position = plant.step(output);
+
+        response.position[i] = position;
+        response.overshoot = fmax(response.overshoot, position - MOVE_DISTANCE);
+        if (fabs(position - MOVE_DISTANCE) > SETTLE_BAND) {
+            response.settleTime = (i + 1) * SIM_DT;
+        }
+    }
+}
+
+/**
+ * Returns the largest distance between two responses at any time
+*/
+static double curveDistance(const Response& a, const Response& b) {
+    double largest = 0;
+    for (int i = 0; i < SIM_STEPS; i++) {
+        largest = fmax(largest, fabs(a.position[i] - b.position[i]));
+    }
+    return largest;
+}
+
+/**
+ * Number of failed checks
+*/
+static int failures = 0;
+
+/**
+ * Print a check and count it if it failed
+*/
+static void check(bool passed, const char* description, double value) {
+    printf("  %-4s %-48s %.3g\n", passed ? "ok" : "FAIL", description, value);
+    if (!passed) {
+        failures++;
+    }
+}
+
+static Response timed[4], perStep[4], templated[4];
+
+int main() {
+    const int periods[] = {5, 10, 20, 0};
+    const char* names[] = {"5ms", "10ms", "20ms", "2-18ms"};
+    PIDInfo stepGains(gains.p, gains.i * TUNED_PERIOD, gains.d / TUNED_PERIOD);
+
+    for (int r = 0; r < 4; r++) {
+        PIDController controller = makeController(gains);
+        runMove([&](double sense, double dt) { return controller.step(sense, dt); }, periods[r], timed[r]);
+
+        PIDController oldController = makeController(stepGains);
+        runMove([&](double sense, double) { return oldController.step(sense, 1); }, periods[r], perStep[r]);
+
+        PID<> bare(gains);
+        bare.target = MOVE_DISTANCE;
+        runMove([&](double sense, double dt) { return bare.step(sense, dt); }, periods[r], templated[r]);
+    }
+
+    printf("%-8s %22s %22s\n", "", "step(sense, dt)", "per step gains");
+    printf("%-8s %11s %10s %11s %10s\n", "rate", "overshoot", "settled", "overshoot", "settled");
+    for (int r = 0; r < 4; r++) {
+        printf("%-8s %9.2fin %9.3fs %9.2fin %9.3fs\n", names[r], timed[r].overshoot, timed[r].settleTime,
+            perStep[r].overshoot, perStep[r].settleTime);
+    }
+    printf("\n");
+
+    const Response& reference = timed[1];
+    for (int r = 0; r < 4; r++) {
+        if (r == 1) {
+            continue;
+        }
+        printf("%s against 10ms\n", names[r]);
+        double distance = curveDistance(timed[r], reference);
+        check(distance <= CURVE_BOUND, "largest distance from the 10ms response (in)", distance);
+        check(fabs(timed[r].settleTime - reference.settleTime) <= SETTLE_BOUND, "settle time difference (s)",
+            fabs(timed[r].settleTime - reference.settleTime));
+
+        // Per step gains drift from the response they were tuned for
+        double oldDistance = curveDistance(perStep[r], perStep[1]);
+        check(oldDistance > distance, "per step gains, distance from 10ms (in)", oldDistance);
+    }
+
+    printf("PID<> against PIDController\n");
+    double templateDistance = 0;
+    for (int r = 0; r < 4; r++) {
+        templateDistance = fmax(templateDistance, curveDistance(templated[r], timed[r]));
+    }
+    check(templateDistance <= TEMPLATE_BOUND, "largest distance at any rate (in)", templateDistance);
+
+    printf("\n%s\n", failures == 0 ? "All checks passed" : "Some checks failed");
+    return failures == 0 ? 0 : 1;
+}
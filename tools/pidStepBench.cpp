@@ -0,0 +1,213 @@
+/**
+ * \file pidStepBench.cpp
+ *
+ * \brief Compares the cost of a step of the PID class template with PIDController, before and after it stopped using the heap.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include -iquote include/control tools/pidStepBench.cpp src/control/PID.cpp -o pidStepBench
+ *     ./pidStepBench
+ *
+ * OldPIDController is a copy of PIDController as it was before PID<Policies...>, created with new
+ * like DrivetrainPID did and calling pros::millis() on every step, with fabs() in place of its
+ * abs() on doubles. The current PIDController from src/control/PID.cpp is timed through
+ * step(sense, dt). The template is timed bare, with the clamp and limit DrivetrainPID would
+ * use, and with every feature. Before timing, each template with every feature set so that it does
+ * nothing is checked against PID<>, since unused settings must not change the output. Exits with 1
+ * if they differ by more than the tolerance.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include "control/policyPID.h"
+
+/**
+ * Largest allowed difference from PID<> as a fraction of its output. Derivative on measurement
+ * subtracts in a different order, so this allows for rounding
+*/
+#define POLICY_TOLERANCE 1e-9
+
+/**
+ * Number of steps run in the check
+*/
+#define CHECK_STEPS 2000
+
+/**
+ * Number of timed steps per controller
+*/
+#define BENCH_STEPS 20000000
+
+/**
+ * Sink for results so the compiler can't remove the work being timed
+*/
+static volatile double sink;
+
+/**
+ * Simulated clock in microseconds, only used for settling
+*/
+static uint64_t simMicros = 0;
+
+extern "C" uint64_t micros(void) {
+    return simMicros;
+}
+
+extern "C" uint32_t millis(void) {
+    return simMicros / 1000;
+}
+
+/**
+ * \brief PIDController before it was replaced, stepped once per loop with no time step
+*/
+class OldPIDController {
+    private:
+        double sense; // Current sensor value
+        double speed; // Calculated new speed
+        double lastError; // Last error value
+        double error; // Calculated error from sensor value and target
+        double integral; // Integral (sum of errors) during PID loop
+        double derivative; // Derivative during PID loop
+        double settleStart; // Time at which settling has started
+        bool settling, settled = false; // Settle flags
+        double tolerance; // Tolerance value until settlable
+        double integralTolerance; // Integral tolerance for integral threshold (?)
+        PIDInfo constants; // PID gain constants
+    public:
+        double target;
+
+        OldPIDController(double target, PIDInfo constants, double tolerance, double integralTolerance);
+        double step(double newSense);
+};
+
+__attribute__((noinline)) OldPIDController::OldPIDController(double target, PIDInfo constants, double tolerance, double integralTolerance) {
+    this->target = target;
+    this->lastError = 1.7E308;
+    this->constants = constants;
+    this->tolerance = tolerance;
+    this->integralTolerance = integralTolerance;
+}
+
+__attribute__((noinline)) double OldPIDController::step(double newSense) {
+    this->sense = newSense;
+    this->error = this->target - this->sense;
+    if (this->lastError == 1.7E308) {
+        this->lastError = this->error;
+    }
+    this->integral += this->error;
+    this->derivative = this->error - this->lastError;
+    this->lastError = this->error;
+    if (this->error == 0 || fabs(this->error) > this->integralTolerance) {
+        this->integral = 0;
+    }
+    this->speed = (this->constants.p * this->error) + (this->constants.i * integral) + (this->constants.d * derivative);
+    if (fabs(this->error) <= this->tolerance) {
+        if (!this->settling) {
+            this->settleStart = millis();
+        }
+        this->settling = true;
+        this->speed = 0;
+        if (millis() - this->settleStart > 2000) {
+            this->settled = true;
+        }
+    } else {
+        this->settling = false;
+        this->settled = false;
+    }
+    return this->speed;
+}
+
+/**
+ * Number of sensor readings, repeated through the steps
+*/
+#define SENSE_COUNT 4096
+
+/**
+ * Sensor readings, a slow swing through the target with some noise. Computed ahead so timing
+ * doesn't include them
+*/
+static double senses[SENSE_COUNT];
+
+/**
+ * Sensor reading for a step
+*/
+static double senseAt(int s) {
+    return senses[s % SENSE_COUNT];
+}
+
+/**
+ * Step a controller alongside PID<> with the same gains
+ * @return The largest difference between their outputs as a fraction of PID<>'s output
+*/
+template <typename Controller>
+static double compareBare(Controller controller) {
+    PID<> bare(controller.getConstants());
+    bare.target = controller.target = 10;
+    double largest = 0;
+    for (int s = 0; s < CHECK_STEPS; s++) {
+        double expected = bare.step(senseAt(s), 0.01);
+        double output = controller.step(senseAt(s), 0.01);
+        largest = fmax(largest, fabs(output - expected) / fmax(1, fabs(expected)));
+    }
+    return largest;
+}
+
+/**
+ * Time BENCH_STEPS steps of a controller
+ * @return Nanoseconds per step
+*/
+template <typename Step>
+static double timeSteps(Step step) {
+    double total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < BENCH_STEPS; s++) {
+        total += step(senseAt(s));
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    sink = total;
+    return elapsed.count() / BENCH_STEPS;
+}
+
+int main() {
+    using namespace PIDPolicy;
+    PIDInfo constants(8, 0.5, 0.4);
+    for (int i = 0; i < SENSE_COUNT; i++) {
+        senses[i] = 40 * sin(2 * M_PI * i / SENSE_COUNT) + 0.05 * (i % 13 - 6);
+    }
+
+    // Every feature set so it does nothing should give the same output as no features
+    double largest = 0;
+    largest = fmax(largest, compareBare(PID<IntegralClamp>(constants, IntegralClamp(INFINITY))));
+    largest = fmax(largest, compareBare(PID<DerivativeOnMeasurement>(constants, DerivativeOnMeasurement())));
+    largest = fmax(largest, compareBare(PID<DerivativeFilter>(constants, DerivativeFilter(1))));
+    largest = fmax(largest, compareBare(PID<Feedforward>(constants, Feedforward(0))));
+    largest = fmax(largest, compareBare(PID<OutputLimit>(constants, OutputLimit(-INFINITY, INFINITY))));
+    largest = fmax(largest, compareBare(PID<Slew>(constants, Slew(INFINITY))));
+    bool passed = largest <= POLICY_TOLERANCE;
+    printf("%-4s largest difference of unused features from PID<> %.3g of its output (tolerance %.0e)\n\n",
+        passed ? "ok" : "FAIL", largest, POLICY_TOLERANCE);
+
+    typedef PID<IntegralClamp, OutputLimit> ClampedPID;
+    typedef PID<IntegralClamp, DerivativeOnMeasurement, DerivativeFilter, Feedforward, OutputLimit, Slew> FullPID;
+
+    OldPIDController* old = new OldPIDController(10, constants, 1, 10);
+    PIDController current(10, constants, SettleCriteria(1), 10);
+    PID<> bare(constants);
+    ClampedPID clamped(constants, IntegralClamp(10), OutputLimit());
+    FullPID full(constants, IntegralClamp(10), DerivativeOnMeasurement(), DerivativeFilter(0.5), Feedforward(0.1), OutputLimit(), Slew(2000));
+    bare.target = clamped.target = full.target = 10;
+
+    printf("%-44s %8s %12s\n", "controller", "bytes", "ns per step");
+    printf("%-44s %8zu %12.2f\n", "old PIDController, heap, millis() per step", sizeof(OldPIDController),
+        timeSteps([&](double sense) { return old->step(sense); }));
+    printf("%-44s %8zu %12.2f\n", "PIDController::step(sense, dt)", sizeof(PIDController),
+        timeSteps([&](double sense) { return current.step(sense, 0.01); }));
+    printf("%-44s %8zu %12.2f\n", "PID<>", sizeof(PID<>),
+        timeSteps([&](double sense) { return bare.step(sense, 0.01); }));
+    printf("%-44s %8zu %12.2f\n", "PID<IntegralClamp, OutputLimit>", sizeof(ClampedPID),
+        timeSteps([&](double sense) { return clamped.step(sense, 0.01); }));
+    printf("%-44s %8zu %12.2f\n", "PID<every feature>", sizeof(FullPID),
+        timeSteps([&](double sense) { return full.step(sense, 0.01); }));
+
+    delete old;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+/**
+ * \file pidTuneSim.cpp
+ * 
+ * \brief Runs the relay feedback tuner used on the robot against a plant model off the robot.
+ * 
+ * Useful for checking tuner settings and tuning rules without a robot. Build and run with:
+ * 
+ *     g++ -O2 -std=gnu++17 -iquote include tools/pidTuneSim.cpp src/control/relayTuner.cpp -o pidTuneSim
+ *     ./pidTuneSim [--gain k] [--tau s] [--delay s] [--setpoint x] [--amplitude u] [--save path]
+ * 
+ * The plant is a motor driving an inertia: velocity approaches gain * output with time
+ * constant tau, and the output reaches the motor after a dead time. Gains saved with --save
+ * can be copied onto the SD card to be loaded at startup.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "control/relayTuner.h"
+#include "control/policyPID.h"
+#include "plantModel.h"
+
+/**
+ * Simulate a step response with the given gains and print how it went
+*/
+static void simulateStep(const char* name, PIDInfo gains, double gain, double tau, double delay, double setpoint) {
+    Plant plant(gain, tau, delay);
+    // Clamp the integral to a tenth of the output range, like the integral tolerance does on the robot,
+    // since the position plant integrates on its own and would wind up during saturated steps
+    double integralLimit = gains.i > 0 ? 12.7 / gains.i : 0;
+    PID<PIDPolicy::IntegralClamp, PIDPolicy::OutputLimit> controller(gains, PIDPolicy::IntegralClamp(integralLimit), PIDPolicy::OutputLimit());
+    controller.target = setpoint;
+
+    double position = 0, maxPosition = 0, settleTime = -1;
+    for (int i = 0; i < 10 / SIM_DT; i++) {
+        position = plant.step(controller.step(position, SIM_DT));
+        maxPosition = fmax(maxPosition, position);
+
+        // Settled once within 2% of the setpoint for good
+        if (fabs(position - setpoint) > 0.02 * fabs(setpoint)) {
+            settleTime = -1;
+        } else if (settleTime < 0) {
+            settleTime = i * SIM_DT;
+        }
+    }
+
+    printf("%-16s p %8.4f  i %8.4f  d %8.4f  overshoot %5.1f%%  ", name, gains.p, gains.i, gains.d,
+           100 * fmax(0, maxPosition - setpoint) / fabs(setpoint));
+    if (settleTime >= 0) {
+        printf("settles in %.2fs\n", settleTime);
+    } else {
+        printf("does not settle\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    double gain = 0.5, tau = 0.15, delay = 0.04;
+    double setpoint = 24, amplitude = 60, hysteresis = 0.1;
+    const char* savePath = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--gain") == 0 && hasValue) {
+            gain = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tau") == 0 && hasValue) {
+            tau = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--delay") == 0 && hasValue) {
+            delay = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--setpoint") == 0 && hasValue) {
+            setpoint = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--amplitude") == 0 && hasValue) {
+            amplitude = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--save") == 0 && hasValue) {
+            savePath = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--gain k] [--tau s] [--delay s] [--setpoint x] [--amplitude u] [--save path]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Run the relay experiment the same way the robot does
+    Plant plant(gain, tau, delay);
+    RelayTuner tuner(setpoint, amplitude, hysteresis);
+    double position = 0, time = 0;
+    while (!tuner.isDone() && time < 60) {
+        position = plant.step(tuner.step(position, SIM_DT));
+        time += SIM_DT;
+    }
+
+    if (!tuner.isDone()) {
+        fprintf(stderr, "the plant did not oscillate, try a larger amplitude\n");
+        return 1;
+    }
+
+    printf("experiment took %.2fs, Ku %.4f, Tu %.3fs\n", time, tuner.getUltimateGain(), tuner.getUltimatePeriod());
+    simulateStep("ziegler-nichols", tuner.getGains(ZIEGLER_NICHOLS), gain, tau, delay, setpoint);
+    simulateStep("some overshoot", tuner.getGains(SOME_OVERSHOOT), gain, tau, delay, setpoint);
+    simulateStep("no overshoot", tuner.getGains(NO_OVERSHOOT), gain, tau, delay, setpoint);
+
+    if (savePath != NULL) {
+        if (!savePIDInfo(savePath, tuner.getGains())) {
+            fprintf(stderr, "%s: could not save gains\n", savePath);
+            return 1;
+        }
+        printf("saved ziegler-nichols gains to %s\n", savePath);
+    }
+
+    return 0;
+}
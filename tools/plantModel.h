@@ -0,0 +1,87 @@
+/**
+ * \file plantModel.h
+ * 
+ * \brief Contains the Plant class, a simple drivetrain model shared by the simulation tools.
+*/
+
+#pragma once
+
+#include <math.h>
+#include <string.h>
+
+/**
+ * Loop period of the simulations in seconds, the same as the drive loops on the robot. Tools
+ * that step their controllers at other rates can define a shorter step before including this
+*/
+#ifndef SIM_DT
+#define SIM_DT 0.01
+#endif
+
+/**
+ * Longest dead time the simulation supports, in steps
+*/
+#define SIM_MAX_DELAY_STEPS 256
+
+/**
+ * \brief First order velocity plant with dead time, integrated to position
+ * 
+ * Models a motor driving an inertia: velocity approaches gain * output with time constant
+ * tau, and the output reaches the motor after a dead time.
+*/
+class Plant {
+    public:
+        /**
+         * Initializes the Plant class
+         * @param gain Steady state velocity per unit of output
+         * @param tau Time constant of the velocity response in seconds
+         * @param delay Dead time between output and response in seconds
+        */
+        Plant(double gain, double tau, double delay) : gain(gain), tau(tau) {
+            this->delaySteps = (int) round(delay / SIM_DT);
+            if (this->delaySteps >= SIM_MAX_DELAY_STEPS) this->delaySteps = SIM_MAX_DELAY_STEPS - 1;
+            memset(this->delayed, 0, sizeof(this->delayed));
+        };
+
+        /**
+         * Advance the plant by one step
+         * @param output The motor output in range [-127, 127]
+         * @return The new position
+        */
+        double step(double output) {
+            output = fmax(-127, fmin(127, output));
+
+            // Queue the output and apply the one from delaySteps ago
+            this->delayed[this->head] = output;
+            double applied = this->delayed[(this->head + SIM_MAX_DELAY_STEPS - this->delaySteps) % SIM_MAX_DELAY_STEPS];
+            this->head = (this->head + 1) % SIM_MAX_DELAY_STEPS;
+
+            this->velocity += (this->gain * applied * this->supply - this->velocity) * SIM_DT / this->tau;
+            this->position += this->velocity * SIM_DT;
+            return this->position;
+        };
+
+        /**
+         * Set the battery voltage as a fraction of the voltage the gain was measured at, which
+         * scales the motor's response to power output
+         * @param supply The supply scale, 1 for a full battery
+        */
+        void setSupply(double supply) { this->supply = supply; };
+
+        /**
+         * Returns the current position
+        */
+        double getPosition() const { return this->position; };
+
+        /**
+         * Returns the current velocity
+        */
+        double getVelocity() const { return this->velocity; };
+
+    private:
+        double gain, tau;
+        double supply = 1;
+        int delaySteps;
+        double delayed[SIM_MAX_DELAY_STEPS];
+        int head = 0;
+        double velocity = 0, position = 0;
+};
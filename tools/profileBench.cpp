@@ -0,0 +1,102 @@
+/**
+ * \file profileBench.cpp
+ *
+ * \brief Measures the cost of building motion profiles and looking up their state.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include tools/profileBench.cpp src/control/motionProfile.cpp -o profileBench
+ *     ./profileBench
+ *
+ * Times building trapezoidal and S-curve profiles of several lengths, then the per-tick cost
+ * of reading the precomputed table against evaluating the profile from its phases, and the
+ * largest difference between the two.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include "control/motionProfile.h"
+
+/**
+ * Number of times each measurement is repeated
+*/
+#define BENCH_REPEATS 2000
+
+/**
+ * Sink for results so the compiler can't remove the work being timed
+*/
+static volatile double sink;
+
+/**
+ * Time how long building a profile takes
+ * @param distance The distance of the profile
+ * @param constraints The limits of the profile
+ * @return Microseconds per build
+*/
+static double timeBuild(double distance, ProfileConstraints constraints) {
+    static MotionProfile profile;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_REPEATS; i++) {
+        profile.build(distance + i * 1e-6, constraints);
+        sink = profile.getDuration();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_REPEATS;
+}
+
+/**
+ * Time one lookup per control tick over the whole profile
+ * @param profile The profile to look up
+ * @param table Whether to read the table or evaluate the phases
+ * @return Nanoseconds per lookup
+*/
+static double timeLookup(const MotionProfile& profile, bool table) {
+    int ticks = (int) (profile.getDuration() / 0.01) + 1;
+    double total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        for (int i = 0; i < ticks; i++) {
+            // Offset the time a little each repeat so results can't be reused
+            double t = i * 0.01 + r * 1e-7;
+            ProfileState state = table ? profile.sample(t) : profile.evaluate(t);
+            total += state.position + state.velocity;
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    sink = total;
+    return elapsed.count() / ((double) BENCH_REPEATS * ticks);
+}
+
+/**
+ * Find the largest difference between the table and the exact profile
+ * @param profile The profile to check
+ * @return The largest position error
+*/
+static double tableError(const MotionProfile& profile) {
+    double worst = 0;
+    for (double t = 0; t <= profile.getDuration(); t += 0.001) {
+        worst = fmax(worst, fabs(profile.sample(t).position - profile.evaluate(t).position));
+    }
+    return worst;
+}
+
+int main() {
+    ProfileConstraints trapezoid(30, 60);
+    ProfileConstraints sCurve(30, 60, 300);
+    double distances[] = {6, 24, 72, 144};
+
+    printf("%-9s %-8s %9s %10s %10s %11s %10s\n", "distance", "profile", "duration", "build(us)",
+        "table(ns)", "evaluate(ns)", "max error");
+    for (double distance : distances) {
+        for (int s = 0; s < 2; s++) {
+            ProfileConstraints constraints = s ? sCurve : trapezoid;
+            static MotionProfile profile;
+            profile.build(distance, constraints);
+            printf("%-9.0f %-8s %8.2fs %10.2f %10.1f %11.1f %10.2e\n", distance, s ? "s-curve" : "trapezoid",
+                profile.getDuration(), timeBuild(distance, constraints), timeLookup(profile, true),
+                timeLookup(profile, false), tableError(profile));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * \file pursuitBench.cpp
+ * 
+ * \brief Measures the per-step cost of PurePursuit against path length.
+ * 
+ * Build and run with:
+ * 
+ *     g++ -O2 -std=gnu++17 -iquote include tools/pursuitBench.cpp src/control/purePursuit.cpp -o pursuitBench
+ *     ./pursuitBench
+ * 
+ * Follows winding paths of increasing length with a kinematic robot, timing PurePursuit's
+ * incremental searches against searching the whole path for the nearest and lookahead points
+ * every step.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include "control/purePursuit.h"
+
+/**
+ * Loop period of the simulation in seconds, the same as followPath() on the robot
+*/
+#define SIM_DT 0.01
+
+/**
+ * Distance between the left and right wheels in inches, the same as WHEELBASE in chassis.h
+*/
+#define SIM_WHEELBASE 10.25
+
+/**
+ * Wheel speed in inches per second per unit of output, about a 200 rpm drive on 3.25" wheels
+*/
+#define SIM_SPEED_GAIN 0.27
+
+/**
+ * Find the lookahead point by searching the whole path, for comparison
+*/
+static Vector2 fullScanLookahead(const std::vector<Vector2>& path, Vector2 position, double lookahead) {
+    // Nearest point over the whole path
+    int nearest = 0;
+    double nearestDistance = INFINITY;
+    for (int i = 0; i < (int) path.size(); i++) {
+        double distance = (path[i] - position).lengthSquared();
+        if (distance < nearestDistance) {
+            nearestDistance = distance;
+            nearest = i;
+        }
+    }
+
+    // First point past the lookahead distance after it
+    for (int i = nearest; i < (int) path.size(); i++) {
+        if ((path[i] - position).lengthSquared() >= lookahead * lookahead) {
+            return path[i];
+        }
+    }
+    return path.back();
+}
+
+/**
+ * Build a winding path with points spaced about half an inch apart
+*/
+static std::vector<Vector2> windingPath(int count) {
+    std::vector<Vector2> path;
+    for (int i = 0; i < count; i++) {
+        double s = i * 0.5;
+        path.push_back(Vector2(12 * sin(s / 24), s));
+    }
+    return path;
+}
+
+int main() {
+    const int lengths[] = {100, 1000, 10000, 100000};
+
+    printf("%8s %8s %14s %14s %12s\n", "points", "steps", "ns/step", "full scan", "max error");
+    for (int count : lengths) {
+        std::vector<Vector2> path = windingPath(count);
+        PurePursuit pursuit(path.data(), count);
+
+        // Follow the path with a kinematic robot, headings are clockwise from +y like Odometry publishes
+        Vector2 position = path[0];
+        double heading = 0, speed = 0, maxError = 0;
+        int steps = 0;
+        std::chrono::nanoseconds elapsed(0);
+
+        PursuitTarget target;
+        while (steps < 1000000) {
+            auto start = std::chrono::steady_clock::now();
+            target = pursuit.step(position, heading, speed);
+            elapsed += std::chrono::steady_clock::now() - start;
+            steps++;
+
+            if (target.done) {
+                break;
+            }
+
+            maxError = fmax(maxError, (path[target.nearestIndex] - position).getMagnitude());
+
+            double vel = pursuit.getSpeed(target) * SIM_SPEED_GAIN;
+            speed = vel;
+            heading += vel * target.curvature * SIM_DT;
+            position = position + Vector2(sin(heading), cos(heading)) * (vel * SIM_DT);
+        }
+
+        // Time the full scan over the same number of steps from points along the path
+        int scanSteps = count >= 10000 ? 200 : steps;
+        auto start = std::chrono::steady_clock::now();
+        volatile double sink = 0; // Keeps the searches from being optimized away
+        for (int i = 0; i < scanSteps; i++) {
+            sink += fullScanLookahead(path, path[(long) i * count / scanSteps], 10).getX();
+        }
+        double scanTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / scanSteps;
+
+        printf("%8d %8d %14.1f %14.1f %11.3fin\n", count, steps, (double) elapsed.count() / steps, scanTime, maxError);
+    }
+
+    return 0;
+}
@@ -0,0 +1,237 @@
+/**
+ * \file seqLockCheck.cpp
+ *
+ * \brief Stress tests SeqLock with a writer and several readers, and compares its read cost with a mutex.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -pthread -iquote include tools/seqLockCheck.cpp -o seqLockCheck
+ *     ./seqLockCheck
+ *
+ * One thread writes PoseSnapshots as fast as it can while several reader threads check that every
+ * snapshot they get comes from a single write and that writes never appear to go backwards. The
+ * same stress is run on a plain copy with no lock to show the check does catch torn reads. Then
+ * the cost of a read is timed for SeqLock and for std::mutex, which stands in for pros::Mutex,
+ * with and without a writer running. Exits with 1 if any SeqLock read was torn or out of order.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+#include "tracking.h"
+
+/**
+ * How long each stress run lasts in milliseconds
+*/
+#define STRESS_DURATION 2000
+
+/**
+ * Number of reader threads in each stress run
+*/
+#define STRESS_READERS 3
+
+/**
+ * Number of reads timed for each benchmark
+*/
+#define BENCH_READS 2000000
+
+/**
+ * Sink for results so the compiler can't remove the work being timed
+*/
+static volatile double sink;
+
+/**
+ * Returns the snapshot for write number n, where every field can be checked against the timestamp
+*/
+static PoseSnapshot makeSnapshot(uint64_t n) {
+    PoseSnapshot snapshot;
+    snapshot.x = n;
+    snapshot.y = -2.0 * n;
+    snapshot.heading = 3.0 * n;
+    snapshot.cosHeading = n + 1.0;
+    snapshot.sinHeading = n + 2.0;
+    snapshot.timestamp = n;
+    return snapshot;
+}
+
+/**
+ * Compares every field of two snapshots
+*/
+static bool operator==(const PoseSnapshot& a, const PoseSnapshot& b) {
+    return a.x == b.x && a.y == b.y && a.heading == b.heading && a.cosHeading == b.cosHeading &&
+        a.sinHeading == b.sinHeading && a.timestamp == b.timestamp;
+}
+
+/**
+ * Returns whether every field of a snapshot came from the same write
+*/
+static bool isWhole(const PoseSnapshot& snapshot) {
+    return snapshot == makeSnapshot(snapshot.timestamp);
+}
+
+/**
+ * \brief A PoseSnapshot shared with no lock at all, to check the stress run can see a torn read
+*/
+class Unlocked {
+    public:
+        void write(const PoseSnapshot& newValue) {
+            // Copy field by field through volatile so the compiler can't merge or reorder the stores
+            this->value.x = newValue.x;
+            this->value.y = newValue.y;
+            this->value.heading = newValue.heading;
+            this->value.cosHeading = newValue.cosHeading;
+            this->value.sinHeading = newValue.sinHeading;
+            this->value.timestamp = newValue.timestamp;
+        };
+
+        PoseSnapshot read() const {
+            PoseSnapshot copy;
+            copy.x = this->value.x;
+            copy.y = this->value.y;
+            copy.heading = this->value.heading;
+            copy.cosHeading = this->value.cosHeading;
+            copy.sinHeading = this->value.sinHeading;
+            copy.timestamp = this->value.timestamp;
+            return copy;
+        };
+
+    private:
+        volatile PoseSnapshot value;
+};
+
+/**
+ * \brief A PoseSnapshot behind a mutex, the way TrackingData shared its values before SeqLock
+*/
+class Locked {
+    public:
+        void write(const PoseSnapshot& newValue) {
+            std::lock_guard<std::mutex> guard(this->mutex);
+            this->value = newValue;
+        };
+
+        PoseSnapshot read() const {
+            std::lock_guard<std::mutex> guard(this->mutex);
+            return this->value;
+        };
+
+    private:
+        mutable std::mutex mutex;
+        PoseSnapshot value;
+};
+
+/**
+ * \brief Results of a stress run
+*/
+struct StressResult {
+    uint64_t writes = 0;
+    uint64_t reads = 0;
+    uint64_t torn = 0; // Reads with fields from different writes
+    uint64_t backwards = 0; // Reads older than the reader's previous read
+};
+
+/**
+ * Write as fast as possible for STRESS_DURATION while STRESS_READERS threads check every read
+*/
+template <typename Shared>
+static StressResult stress() {
+    Shared shared;
+    shared.write(makeSnapshot(0));
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> reads{0}, torn{0}, backwards{0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < STRESS_READERS; i++) {
+        readers.emplace_back([&]() {
+            uint64_t count = 0, tornCount = 0, backwardsCount = 0, last = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                PoseSnapshot snapshot = shared.read();
+                count++;
+                if (!isWhole(snapshot)) {
+                    tornCount++;
+                } else if (snapshot.timestamp < last) {
+                    backwardsCount++;
+                } else {
+                    last = snapshot.timestamp;
+                }
+            }
+            reads += count;
+            torn += tornCount;
+            backwards += backwardsCount;
+        });
+    }
+
+    StressResult result;
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(STRESS_DURATION);
+    while (std::chrono::steady_clock::now() < end) {
+        for (int i = 0; i < 1000; i++) {
+            shared.write(makeSnapshot(++result.writes));
+        }
+    }
+    running = false;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    result.reads = reads;
+    result.torn = torn;
+    result.backwards = backwards;
+    return result;
+}
+
+/**
+ * Time BENCH_READS reads, with a writer thread updating every writePeriod microseconds if it's above 0
+ * @return Nanoseconds per read
+*/
+template <typename Shared>
+static double timeReads(int writePeriod) {
+    Shared shared;
+    shared.write(makeSnapshot(0));
+    std::atomic<bool> running{true};
+    std::thread writer;
+    if (writePeriod > 0) {
+        writer = std::thread([&]() {
+            uint64_t n = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                shared.write(makeSnapshot(++n));
+                std::this_thread::sleep_for(std::chrono::microseconds(writePeriod));
+            }
+        });
+    }
+
+    double total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_READS; i++) {
+        total += shared.read().x;
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    sink = total;
+
+    running = false;
+    if (writer.joinable()) {
+        writer.join();
+    }
+    return elapsed.count() / BENCH_READS;
+}
+
+int main() {
+    printf("%u hardware threads, %d readers, %.1fs per run\n\n", std::thread::hardware_concurrency(),
+        STRESS_READERS, STRESS_DURATION / 1000.0);
+    printf("%-10s %12s %12s %10s %10s\n", "shared by", "writes", "reads", "torn", "backwards");
+    StressResult unlocked = stress<Unlocked>();
+    printf("%-10s %12llu %12llu %10llu %10llu\n", "no lock", (unsigned long long) unlocked.writes,
+        (unsigned long long) unlocked.reads, (unsigned long long) unlocked.torn, (unsigned long long) unlocked.backwards);
+    StressResult locked = stress<SeqLock<PoseSnapshot>>();
+    printf("%-10s %12llu %12llu %10llu %10llu\n\n", "SeqLock", (unsigned long long) locked.writes,
+        (unsigned long long) locked.reads, (unsigned long long) locked.torn, (unsigned long long) locked.backwards);
+
+    printf("%-10s %18s %18s\n", "read cost", "no writer (ns)", "100us writer (ns)");
+    printf("%-10s %18.1f %18.1f\n", "SeqLock", timeReads<SeqLock<PoseSnapshot>>(0), timeReads<SeqLock<PoseSnapshot>>(100));
+    printf("%-10s %18.1f %18.1f\n", "mutex", timeReads<Locked>(0), timeReads<Locked>(100));
+
+    bool passed = locked.torn == 0 && locked.backwards == 0 && locked.reads > 0;
+    printf("\n%s\n", passed ? "Every SeqLock read came from a single write, in order" : "FAIL SeqLock returned a torn or out of order read");
+    return passed ? 0 : 1;
+}
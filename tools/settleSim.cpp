@@ -0,0 +1,221 @@
+/**
+ * \file settleSim.cpp
+ *
+ * \brief Compares how long myAuton() takes with the old 2 second settle delay against the new settle criteria.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include -iquote include/control tools/settleSim.cpp src/control/PID.cpp \
+ *         src/tracking/odometry.cpp src/tracking/odomEKF.cpp -o settleSim
+ *     ./settleSim [--tau s] [--delay s]
+ *
+ * Runs the motions in myAuton() with the real PIDController, stepped through its pros::micros()
+ * clock which is stubbed here with the simulation time, on a drivetrain model tracked by the real
+ * Odometry class. The loops around the controllers are copies of DrivetrainPID::runMoveToPoint and
+ * runRotateTo, running every 20ms like the motion task. The routine is run twice: with the old
+ * settle rule (error within tolerance for 2 seconds) and with SettleCriteria's defaults (the same
+ * tolerance for DEFAULT_SETTLE_DWELL). myAuton()'s comments give its targets in feet, so they are
+ * driven in inches here. The times are for this model only. Exits with 1 if the new settle rule
+ * ends any motion outside its tolerance.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "control/PID.h"
+#include "trackedRobot.h"
+
+/**
+ * Distance between the left and right wheels in inches, the same as WHEELBASE in chassis.h
+*/
+#define SIM_WHEELBASE 10.25
+
+/**
+ * Period of the motion task's loops in seconds, the pros::delay(20) in DrivetrainPID
+*/
+#define MOTION_PERIOD 0.02
+
+/**
+ * Longest simulated motion in seconds
+*/
+#define SIM_TIMEOUT 10
+
+/**
+ * Settle delay in seconds that PIDController used before SettleCriteria
+*/
+#define OLD_SETTLE_DELAY 2.0
+
+/**
+ * Simulation time in microseconds, read by PIDController::step() through pros::micros(). Starts
+ * above 0, which PIDController takes to mean it has not stepped yet
+*/
+static uint64_t simMicros = 1000000;
+
+extern "C" uint64_t micros(void) {
+    return simMicros;
+}
+
+/**
+ * \brief Runs myAuton()'s motions on a simulated robot
+*/
+class Routine {
+    public:
+        /**
+         * Initializes the Routine class
+         * @param drive Drive controller, measuring distance to the target in inches
+         * @param turn Turn controller, measuring heading in radians
+        */
+        Routine(PIDController drive, PIDController turn, double tau, double delay)
+            : robot(SensorRobot(SIM_WHEELBASE, 0, tau, delay), SIM_WHEELBASE), drive(drive), turn(turn) {};
+
+        /**
+         * Turn in place to a heading like DrivetrainPID::runRotateTo
+        */
+        void rotateTo(double target) {
+            double start = this->robot.robot.time;
+            this->turn.reset();
+            this->turn.target = target;
+
+            do {
+                double output = this->turn.step(this->robot.getHeading());
+                this->wait([&]() { this->robot.step(output, -output); });
+            } while (!this->turn.isDone() && this->robot.robot.time - start < SIM_TIMEOUT);
+
+            this->record("rotate", this->robot.robot.time - start, fabs(remainder(target - this->robot.getHeading(), 2 * M_PI)) * 180 / M_PI, "deg");
+        };
+
+        /**
+         * Turn to face a point then drive to it like DrivetrainPID::runMoveToPoint
+        */
+        void moveToPoint(Vector2 target) {
+            this->rotateTo((target - this->robot.getPos()).getHeading());
+
+            double start = this->robot.robot.time;
+            this->drive.reset();
+            this->drive.target = 0;
+
+            do {
+                Vector2 delta = target - this->robot.getPos();
+                double vel = -this->drive.step(delta.getMagnitude());
+
+                double headingError = remainder(delta.getHeading() - this->robot.getHeading(), 2 * M_PI);
+                double forward = fabs(vel) * cos(headingError);
+                if (forward < 0) {
+                    headingError = remainder(headingError + M_PI, 2 * M_PI);
+                }
+                double turn = this->turn.getConstants().p * headingError;
+                this->wait([&]() { this->arcade(forward, turn); });
+            } while (!this->drive.isDone() && this->robot.robot.time - start < SIM_TIMEOUT);
+
+            this->record("drive", this->robot.robot.time - start, (target - this->robot.getPos()).getMagnitude(), "in");
+        };
+
+        /**
+         * Keep the last outputs for a number of seconds, like pros::delay() between motions
+        */
+        void delay(double seconds) {
+            for (double t = 0; t < seconds - 1e-9; t += SIM_DT) {
+                this->robot.step(0, 0);
+                simMicros += SIM_DT * 1000000;
+            }
+        };
+
+        TrackedRobot robot;
+        double durations[8];
+        double errors[8];
+        const char* names[8];
+        const char* units[8];
+        int motions = 0;
+
+    private:
+        PIDController drive, turn;
+
+        /**
+         * Apply outputs until the next iteration of the motion loop, like pros::delay(20)
+        */
+        template <typename Output>
+        void wait(Output output) {
+            for (int i = 0; i < (int) round(MOTION_PERIOD / SIM_DT); i++) {
+                output();
+                simMicros += SIM_DT * 1000000;
+            }
+        };
+
+        /**
+         * Send forward and clockwise turn outputs to the robot, like DrivetrainPID::driveArcade
+        */
+        void arcade(double forward, double turn) {
+            double scale = fabs(forward) + fabs(turn) > 127 ? (127 - fmin(fabs(turn), 127)) / fabs(forward) : 1;
+            this->robot.step(forward * scale + turn, forward * scale - turn);
+        };
+
+        void record(const char* name, double duration, double error, const char* unit) {
+            this->names[this->motions] = name;
+            this->durations[this->motions] = duration;
+            this->errors[this->motions] = error;
+            this->units[this->motions] = unit;
+            this->motions++;
+        };
+};
+
+/**
+ * Run myAuton() with the drive and turn controllers settling by the given criteria
+*/
+static Routine runAuton(PIDInfo driveConstants, PIDInfo turnConstants, SettleCriteria driveSettle, SettleCriteria turnSettle, double tau, double delay) {
+    Routine routine(PIDController(0, driveConstants, driveSettle, 1), PIDController(0, turnConstants, turnSettle, 1), tau, delay);
+
+    routine.moveToPoint(Vector2(12, 12));
+    routine.delay(0.04);
+    routine.rotateTo(M_PI / 2);
+
+    // moveToOrientation drives to the point then turns to the angle
+    routine.moveToPoint(Vector2(120, 120));
+    routine.rotateTo(95 * M_PI / 180);
+    return routine;
+}
+
+int main(int argc, char** argv) {
+    double tau = 0.15, delay = 0.03;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--tau") == 0 && hasValue) {
+            tau = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--delay") == 0 && hasValue) {
+            delay = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--tau s] [--delay s]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Same gains as the other simulators. DrivetrainPID is built with a tolerance of 1, which is
+    // used as inches for driving, and as 1 degree for turning rather than 1 radian
+    PIDInfo driveConstants(8, 0, 0.5), turnConstants(60, 0, 4);
+    const double driveTolerance = 1, turnTolerance = M_PI / 180;
+
+    Routine before = runAuton(driveConstants, turnConstants, SettleCriteria(driveTolerance, INFINITY, OLD_SETTLE_DELAY),
+        SettleCriteria(turnTolerance, INFINITY, OLD_SETTLE_DELAY), tau, delay);
+    Routine after = runAuton(driveConstants, turnConstants, SettleCriteria(driveTolerance), SettleCriteria(turnTolerance), tau, delay);
+
+    printf("model only: myAuton(), settled for %.2fs before and %.2fs after\n\n", OLD_SETTLE_DELAY, DEFAULT_SETTLE_DWELL);
+    printf("%-8s %10s %10s %14s %14s\n", "motion", "before (s)", "after (s)", "before error", "after error");
+    bool passed = true;
+    for (int i = 0; i < after.motions; i++) {
+        printf("%-8s %10.2f %10.2f %11.3f %-2s %11.3f %-2s\n", after.names[i], before.durations[i], after.durations[i],
+            before.errors[i], before.units[i], after.errors[i], after.units[i]);
+
+        double tolerance = strcmp(after.units[i], "in") == 0 ? driveTolerance : 1;
+        passed = passed && after.errors[i] <= tolerance;
+    }
+
+    double beforeTime = before.robot.robot.time, afterTime = after.robot.robot.time;
+    printf("\n%-8s %10.2f %10.2f\n", "total", beforeTime, afterTime);
+    printf("saved %.2fs (%.0f%%)\n", beforeTime - afterTime, 100 * (beforeTime - afterTime) / beforeTime);
+
+    if (!passed) {
+        printf("FAIL a motion ended outside its tolerance with the new settle criteria\n");
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+/**
+ * \file splineBench.cpp
+ *
+ * \brief Measures the cost of building spline paths and looking up points by distance.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include tools/splineBench.cpp src/control/splinePath.cpp -o splineBench
+ *     ./splineBench
+ *
+ * Builds winding routes of 10 to 100 waypoints with both kinds of curve, then times looking up
+ * points by distance with the arc length table against integrating along the path from the
+ * start on every lookup. Also reports how far table lookups are from a finely integrated distance and
+ * the largest jump in curvature along the path.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include "control/splinePath.h"
+
+/**
+ * Number of lookups timed for each route
+*/
+#define BENCH_LOOKUPS 20000
+
+/**
+ * Integration steps per segment for the integrating lookup
+*/
+#define BENCH_INTEGRATION_STEPS 64
+
+/**
+ * Integration steps per segment when checking the table's accuracy
+*/
+#define BENCH_REFERENCE_STEPS 4096
+
+/**
+ * Sink for results so the compiler can't remove the work being timed
+*/
+static volatile double sink;
+
+/**
+ * Make a winding route, heading at each waypoint towards the next
+ * @param count The number of waypoints
+*/
+static std::vector<Waypoint> makeRoute(int count) {
+    std::vector<Vector2> points(count);
+    for (int i = 0; i < count; i++) {
+        points[i] = Vector2(24 * i, 18 * sin(i * 1.3) + 6 * cos(i * 0.7));
+    }
+
+    std::vector<Waypoint> route(count);
+    for (int i = 0; i < count; i++) {
+        Vector2 direction = points[i < count - 1 ? i + 1 : i] - points[i > 0 ? i - 1 : i];
+        route[i] = Waypoint(points[i], atan2(direction.getX(), direction.getY()));
+    }
+    return route;
+}
+
+/**
+ * Find the point at a distance by integrating along the path from the start, what lookups cost
+ * without a table
+ * @param stepsPerSegment Number of straight lines each segment is split into
+*/
+static Vector2 integratedLookup(const SplinePath& path, double distance, int stepsPerSegment = BENCH_INTEGRATION_STEPS) {
+    double step = 1.0 / stepsPerSegment;
+    int steps = path.getSegmentCount() * stepsPerSegment;
+    Vector2 last = path.getPosition(0);
+    double travelled = 0;
+    for (int i = 1; i <= steps; i++) {
+        Vector2 next = path.getPosition(i * step);
+        double length = (next - last).getMagnitude();
+        if (travelled + length >= distance) {
+            return path.getPosition((i - 1 + (distance - travelled) / length) * step);
+        }
+        travelled += length;
+        last = next;
+    }
+    return last;
+}
+
+/**
+ * Time lookups spread over the path
+ * @return Nanoseconds per lookup
+*/
+template <typename F>
+static double timeLookups(const SplinePath& path, int lookups, F lookup) {
+    double length = path.getLength();
+    double total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < lookups; i++) {
+        // Step through the path out of order so lookups don't follow each other
+        double distance = fmod(i * 0.618034 * length, length);
+        total += lookup(distance).getX();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    sink = total;
+    return elapsed.count() / lookups;
+}
+
+int main() {
+    int counts[] = {10, 25, 50, 100};
+    const char* names[] = {"bezier", "quintic"};
+
+    printf("%-10s %-8s %8s %10s %11s %14s %11s %12s\n", "waypoints", "curve", "length", "build(us)",
+        "table(ns)", "integrate(ns)", "error(in)", "max dk(1/in)");
+    for (int count : counts) {
+        std::vector<Waypoint> route = makeRoute(count);
+        for (int type = SPLINE_CUBIC_BEZIER; type <= SPLINE_QUINTIC_HERMITE; type++) {
+            // Build time
+            int builds = 2000 / count;
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < builds; i++) {
+                SplinePath built(route.data(), count, (SPLINE_TYPE) type);
+                sink = built.getLength();
+            }
+            std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+            SplinePath path(route.data(), count, (SPLINE_TYPE) type);
+
+            double table = timeLookups(path, BENCH_LOOKUPS, [&](double d) { return path.sample(d).position; });
+            double integrate = timeLookups(path, BENCH_LOOKUPS / count, [&](double d) { return integratedLookup(path, d); });
+
+            // Accuracy against integration, and the largest curvature jump between close samples
+            double error = 0, jump = 0;
+            std::vector<PathSample> samples = path.sampleEvenly(0.05);
+            for (int i = 0; i < (int) samples.size(); i++) {
+                if (i % 400 == 0) {
+                    error = fmax(error, (samples[i].position - integratedLookup(path, samples[i].distance, BENCH_REFERENCE_STEPS)).getMagnitude());
+                }
+                if (i > 0) {
+                    jump = fmax(jump, fabs(samples[i].curvature - samples[i - 1].curvature));
+                }
+            }
+
+            printf("%-10d %-8s %7.0fin %10.1f %11.1f %14.0f %11.4f %12.4f\n", count, names[type], path.getLength(),
+                elapsed.count() / builds, table, integrate, error, jump);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * \file trackedRobot.h
+ *
+ * \brief Contains the SensorRobot and TrackedRobot classes, a skid steer drivetrain model that is
+ * tracked by the real Odometry class.
+ *
+ * Tools using this need src/tracking/odometry.cpp and src/tracking/odomEKF.cpp in their build.
+*/
+
+#pragma once
+
+#include <math.h>
+#include "tracking/odometry.h"
+#include "control/trajectoryTracker.h"
+#include "plantModel.h"
+
+/**
+ * Wheel speed in inches per second per unit of output, about a 200 rpm drive on 3.25" wheels
+*/
+#define SIM_SPEED_GAIN 0.27
+
+/**
+ * Diameter of the tracking wheels in inches, the same as TRACKING_WHEEL_DIAMETER in chassis.h
+*/
+#define SIM_TRACKING_WHEEL_DIAMETER 2.75
+
+/**
+ * \brief Skid steer robot that reports sensor readings, with tracking wheels in line with the drive wheels
+ *
+ * The robot doesn't know about headings, it only produces tracking wheel ticks and a clockwise
+ * positive IMU rotation like the real sensors. The true pose is kept in the frame Odometry starts
+ * in, with +y ahead of the robot and +x to its right, so driving the left side faster turns the
+ * robot clockwise from +y towards +x.
+*/
+class SensorRobot {
+    public:
+        /**
+         * Initializes the SensorRobot class
+         * @param wheelbase Distance between the left and right wheels in inches
+         * @param mismatch How much weaker the right side is than the left, as a fraction
+         * @param tau Time constant of each side's velocity response in seconds
+         * @param delay Dead time between output and response in seconds
+        */
+        SensorRobot(double wheelbase, double mismatch = 0, double tau = 0.08, double delay = 0.02)
+            : wheelbase(wheelbase), left(SIM_SPEED_GAIN, tau, delay), right(SIM_SPEED_GAIN * (1 - mismatch), tau, delay) {};
+
+        /**
+         * Advance the robot by one step
+         * @param leftPower Power for the left side in range [-127, 127]
+         * @param rightPower Power for the right side in range [-127, 127]
+        */
+        void step(double leftPower, double rightPower) {
+            double leftMoved = this->left.step(leftPower) - this->leftDistance;
+            double rightMoved = this->right.step(rightPower) - this->rightDistance;
+            this->leftDistance += leftMoved;
+            this->rightDistance += rightMoved;
+
+            // Drive along the chord of the arc, turning clockwise when the left side moves further
+            double turned = (leftMoved - rightMoved) / this->wheelbase;
+            double moved = (leftMoved + rightMoved) / 2;
+            double middle = this->rotation + turned / 2;
+            this->x += moved * sin(middle);
+            this->y += moved * cos(middle);
+            this->rotation += turned;
+            this->rate = turned / SIM_DT;
+            this->time += SIM_DT;
+        };
+
+        /**
+         * Drive each side at a velocity in inches per second, scaling both down to keep their ratio
+         * if either is too fast like Drivetrain::tankVelocity
+        */
+        void stepVelocity(WheelVelocities wheels) {
+            double maxVelocity = 127 * SIM_SPEED_GAIN;
+            double largest = fmax(fabs(wheels.left), fabs(wheels.right));
+            double scale = largest > maxVelocity ? maxVelocity / largest : 1;
+            this->step(wheels.left * scale / SIM_SPEED_GAIN, wheels.right * scale / SIM_SPEED_GAIN);
+        };
+
+        /**
+         * Turn the robot in place without moving the wheels, ex. to start it off a path
+         * @param degrees How far to turn in degrees, clockwise positive like the IMU
+        */
+        void turnBy(double degrees) { this->rotation += degrees * M_PI / 180; };
+
+        /**
+         * Returns what the sensors read now, like readSensors() in the tracking task
+        */
+        SensorSample read() const {
+            const double inchPerTick = M_PI * SIM_TRACKING_WHEEL_DIAMETER / 360;
+            SensorSample sample;
+            sample.timestamp = (uint32_t) llround(this->time * 1000000);
+            sample.left = (int32_t) lround(this->leftDistance / inchPerTick);
+            sample.right = (int32_t) lround(this->rightDistance / inchPerTick);
+            sample.back = 0;
+            sample.imuRotation = this->rotation * 180 / M_PI;
+            sample.imuRate = this->rate * 180 / M_PI;
+            return sample;
+        };
+
+        /**
+         * Returns the true position of the robot
+        */
+        Vector2 getPos() const { return Vector2(this->x, this->y); };
+
+        double x = 0, y = 0, time = 0;
+
+    private:
+        double wheelbase;
+        Plant left, right;
+        double leftDistance = 0, rightDistance = 0;
+        double rotation = 0, rate = 0; // Clockwise, as the IMU measures it
+};
+
+/**
+ * \brief A SensorRobot with its odometry, stepped together like the tracking task
+*/
+class TrackedRobot {
+    public:
+        /**
+         * Initializes the TrackedRobot class, starting odometry from the robot's current pose
+         * @param robot The robot to track
+         * @param wheelbase Distance between the left and right tracking wheels in inches
+        */
+        TrackedRobot(SensorRobot robot, double wheelbase)
+            : robot(robot), odometry(OdomGeometry{(float) wheelbase, 0, SIM_TRACKING_WHEEL_DIAMETER}) {
+            this->odometry.reset(robot.x, robot.y, robot.read());
+        };
+
+        /**
+         * Advance the robot by one step, then run odometry on the new sensor readings
+        */
+        void step(double leftPower, double rightPower) {
+            this->robot.step(leftPower, rightPower);
+            this->odometry.step(this->robot.read());
+        };
+
+        /**
+         * Drive each side at a velocity for one step, then run odometry on the new sensor readings
+        */
+        void stepVelocity(WheelVelocities wheels) {
+            this->robot.stepVelocity(wheels);
+            this->odometry.step(this->robot.read());
+        };
+
+        /**
+         * Returns the position the controllers see, the same value the tracking task publishes
+        */
+        Vector2 getPos() const { return this->odometry.getPos(); };
+
+        /**
+         * Returns the heading the controllers see, the same value the tracking task publishes
+        */
+        double getHeading() const { return this->odometry.getHeading(); };
+
+        SensorRobot robot;
+        Odometry odometry;
+};
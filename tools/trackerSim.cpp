@@ -0,0 +1,205 @@
+/**
+ * \file trackerSim.cpp
+ *
+ * \brief Compares trajectory trackers (RAMSETE and MPC) and pure pursuit on a simulated skid steer drivetrain.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include tools/trackerSim.cpp src/control/ramsete.cpp src/control/trajectory.cpp src/control/splinePath.cpp src/control/purePursuit.cpp \
+ *         src/tracking/odometry.cpp src/tracking/odomEKF.cpp -o trackerSim
+ *     ./trackerSim [--mismatch fraction] [--tau s] [--delay s] [--b gain] [--zeta ratio]
+ *
+ * Each side is a Plant under the motor's velocity control. The right side is weaker than the
+ * left by the mismatch fraction and the robot starts off the path, so a controller that only
+ * plays back the trajectory's velocities drifts away from it. The controllers only see the pose
+ * the real Odometry class tracks from the simulated sensors, like on the robot. Reports the true
+ * distance from the path along the route, the distance from the end when the route is done and
+ * the route time.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "control/purePursuit.h"
+#include "control/mpcTracker.h"
+#include "control/ramsete.h"
+#include "trackedRobot.h"
+
+/**
+ * Distance between the left and right wheels in inches, the same as WHEELBASE in chassis.h
+*/
+#define SIM_WHEELBASE 10.25
+
+/**
+ * Longest simulated route in seconds
+*/
+#define SIM_TIMEOUT 20
+
+/**
+ * \brief Plays back the trajectory's wheel velocities without looking at where the robot is
+*/
+class FeedforwardTracker : public TrajectoryTracker {
+    public:
+        WheelVelocities step(const Trajectory& trajectory, double t, Vector2 /*position*/, double /*heading*/) override {
+            TrajectoryState reference = trajectory.sample(t);
+            WheelVelocities wheels;
+            wheels.left = reference.velocity + reference.angularVelocity * SIM_WHEELBASE / 2;
+            wheels.right = reference.velocity - reference.angularVelocity * SIM_WHEELBASE / 2;
+            return wheels;
+        };
+};
+
+/**
+ * \brief Results of driving a route
+*/
+struct Result {
+    double time = 0; // Route time in seconds
+    double maxError = 0; // Largest distance from the path in inches
+    double rmsError = 0; // Root mean square distance from the path in inches
+    double finalError = 0; // Distance from the end of the path when done in inches
+};
+
+/**
+ * \brief Accumulates the distance from a densely sampled path
+*/
+class PathError {
+    public:
+        PathError(const std::vector<Vector2>& points) : points(points) {};
+
+        void add(Vector2 position) {
+            double nearest = INFINITY;
+            for (const Vector2& point : this->points) {
+                nearest = fmin(nearest, (point - position).lengthSquared());
+            }
+            this->maxError = fmax(this->maxError, sqrt(nearest));
+            this->sumSquared += nearest;
+            this->count++;
+        };
+
+        void finish(Result& result, Vector2 position) const {
+            result.maxError = this->maxError;
+            result.rmsError = this->count > 0 ? sqrt(this->sumSquared / this->count) : 0;
+            result.finalError = (this->points.back() - position).getMagnitude();
+        };
+
+    private:
+        const std::vector<Vector2>& points;
+        double maxError = 0, sumSquared = 0;
+        int count = 0;
+};
+
+/**
+ * Drive a trajectory with a tracker until its time is up
+*/
+static Result runTracker(TrackedRobot tracked, const Trajectory& trajectory, TrajectoryTracker& tracker, const std::vector<Vector2>& points) {
+    PathError error(points);
+    tracker.reset();
+    while (tracked.robot.time < trajectory.getDuration()) {
+        tracked.stepVelocity(tracker.step(trajectory, tracked.robot.time, tracked.getPos(), tracked.getHeading()));
+        error.add(tracked.robot.getPos());
+    }
+    // Stop at the end
+    tracked.step(0, 0);
+
+    Result result;
+    result.time = tracked.robot.time;
+    error.finish(result, tracked.robot.getPos());
+    return result;
+}
+
+/**
+ * Drive a path with pure pursuit the way DrivetrainPID::followPath does
+*/
+static Result runPursuit(TrackedRobot tracked, const std::vector<Vector2>& points) {
+    PathError error(points);
+    PurePursuit pursuit(points.data(), points.size());
+    Vector2 last = tracked.getPos();
+    while (tracked.robot.time < SIM_TIMEOUT) {
+        // Measure speed from the tracked position like followPath() does
+        Vector2 pos = tracked.getPos();
+        double speed = (pos - last).getMagnitude() / SIM_DT;
+        last = pos;
+
+        PursuitTarget target = pursuit.step(pos, tracked.getHeading(), speed);
+        if (target.done) {
+            break;
+        }
+        double vel = pursuit.getSpeed(target);
+        double left = vel * (1 + target.curvature * SIM_WHEELBASE / 2);
+        double right = vel * (1 - target.curvature * SIM_WHEELBASE / 2);
+        double largest = fmax(fabs(left), fabs(right));
+        if (largest > 127) {
+            left *= 127 / largest;
+            right *= 127 / largest;
+        }
+        tracked.step(left, right);
+        error.add(tracked.robot.getPos());
+    }
+
+    Result result;
+    result.time = tracked.robot.time;
+    error.finish(result, tracked.robot.getPos());
+    return result;
+}
+
+/**
+ * A route to drive
+*/
+struct Route {
+    const char* name;
+    std::vector<Waypoint> waypoints;
+};
+
+int main(int argc, char** argv) {
+    double mismatch = 0.07, tau = 0.08, delay = 0.02;
+    double b = RAMSETE_DEFAULT_B, zeta = RAMSETE_DEFAULT_ZETA;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--mismatch") == 0) mismatch = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "--tau") == 0) tau = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "--delay") == 0) delay = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "--b") == 0) b = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "--zeta") == 0) zeta = atof(argv[i + 1]);
+    }
+
+    Route routes[] = {
+        {"s-bend", {Waypoint(Vector2(0, 0), 0), Waypoint(Vector2(24, 48), M_PI / 2), Waypoint(Vector2(48, 96), 0)}},
+        {"slalom", {Waypoint(Vector2(0, 0), 0), Waypoint(Vector2(18, 24), 0), Waypoint(Vector2(0, 48), 0),
+            Waypoint(Vector2(18, 72), 0), Waypoint(Vector2(0, 96), 0)}},
+        {"u-turn", {Waypoint(Vector2(0, 0), 0), Waypoint(Vector2(0, 48), 0), Waypoint(Vector2(18, 60), M_PI / 2),
+            Waypoint(Vector2(36, 48), M_PI), Waypoint(Vector2(36, 0), M_PI)}},
+    };
+
+    // Plan for 90% of the top wheel speed, leaving room for corrections
+    TrajectoryConstraints constraints(0.9 * 127 * SIM_SPEED_GAIN, 60, SIM_WHEELBASE);
+    FeedforwardTracker feedforward;
+    RamseteTracker ramsete(SIM_WHEELBASE, b, zeta);
+    MPCTracker<MPC_DEFAULT_HORIZON> mpc(SIM_WHEELBASE, 127 * SIM_SPEED_GAIN);
+
+    printf("mismatch %.0f%%, tau %.2fs, delay %.2fs, starting 1.5in and 4deg off the path\n\n", mismatch * 100, tau, delay);
+    printf("%-8s %-12s %7s %13s %13s %13s\n", "route", "controller", "time", "max error", "rms error", "final error");
+    for (const Route& route : routes) {
+        SplinePath path(route.waypoints.data(), route.waypoints.size());
+        Trajectory trajectory(path.sampleEvenly(1), constraints);
+        std::vector<Vector2> points = path.getPoints(0.25);
+
+        SensorRobot robot(SIM_WHEELBASE, mismatch, tau, delay);
+        robot.x = 1.5;
+        robot.turnBy(4);
+        TrackedRobot start(robot, SIM_WHEELBASE);
+
+        Result results[4] = {
+            runPursuit(start, path.getPoints(1)),
+            runTracker(start, trajectory, feedforward, points),
+            runTracker(start, trajectory, ramsete, points),
+            runTracker(start, trajectory, mpc, points),
+        };
+        const char* names[4] = {"pursuit", "feedforward", "ramsete", "mpc"};
+        for (int i = 0; i < 4; i++) {
+            printf("%-8s %-12s %6.2fs %11.2fin %11.2fin %11.2fin\n", route.name, names[i], results[i].time,
+                results[i].maxError, results[i].rmsError, results[i].finalError);
+        }
+    }
+    return 0;
+}
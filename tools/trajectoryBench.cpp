@@ -0,0 +1,90 @@
+/**
+ * \file trajectoryBench.cpp
+ *
+ * \brief Measures the cost of planning trajectories and the route time they save.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include tools/trajectoryBench.cpp src/control/trajectory.cpp src/control/splinePath.cpp -o trajectoryBench
+ *     ./trajectoryBench
+ *
+ * Plans velocities along routes of 200 samples and compares the planned route time against
+ * driving at a constant speed, either the fastest speed that keeps the outer wheel under the
+ * limit in the tightest turn, or full speed, which overspeeds the outer wheel in turns.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include "control/trajectory.h"
+
+/**
+ * Number of samples on each route
+*/
+#define BENCH_SAMPLES 200
+
+/**
+ * Number of times planning is repeated for timing
+*/
+#define BENCH_REPEATS 5000
+
+/**
+ * Distance between the left and right wheels in inches, the same as WHEELBASE in chassis.h
+*/
+#define SIM_WHEELBASE 10.25
+
+/**
+ * Sink for results so the compiler can't remove the work being timed
+*/
+static volatile double sink;
+
+/**
+ * A route to plan
+*/
+struct Route {
+    const char* name;
+    std::vector<Waypoint> waypoints;
+};
+
+int main() {
+    Route routes[] = {
+        {"straight", {Waypoint(Vector2(0, 0), 0), Waypoint(Vector2(0, 96), 0)}},
+        {"s-bend", {Waypoint(Vector2(0, 0), 0), Waypoint(Vector2(24, 48), M_PI / 2), Waypoint(Vector2(48, 96), 0)}},
+        {"slalom", {Waypoint(Vector2(0, 0), 0), Waypoint(Vector2(18, 24), 0), Waypoint(Vector2(0, 48), 0),
+            Waypoint(Vector2(18, 72), 0), Waypoint(Vector2(0, 96), 0)}},
+        {"u-turn", {Waypoint(Vector2(0, 0), 0), Waypoint(Vector2(0, 48), 0), Waypoint(Vector2(18, 60), M_PI / 2),
+            Waypoint(Vector2(36, 48), M_PI), Waypoint(Vector2(36, 0), M_PI)}},
+    };
+    TrajectoryConstraints constraints(60, 120, SIM_WHEELBASE);
+
+    printf("%-9s %7s %9s %9s %12s %12s %11s\n", "route", "length", "plan(us)", "planned", "safe const",
+        "full const", "overspeed");
+    for (const Route& route : routes) {
+        SplinePath path(route.waypoints.data(), route.waypoints.size());
+        std::vector<PathSample> samples = path.sampleEvenly(path.getLength() / (BENCH_SAMPLES - 1));
+
+        Trajectory trajectory;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BENCH_REPEATS; i++) {
+            trajectory.plan(samples, constraints);
+            sink = trajectory.getDuration();
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+        // Constant speed driving still has to speed up and slow down at the ends, at the same acceleration
+        double length = path.getLength();
+        double maxCurvature = 0;
+        for (const PathSample& sample : samples) {
+            maxCurvature = fmax(maxCurvature, fabs(sample.curvature));
+        }
+        double safeSpeed = constraints.maxVelocity / (1 + maxCurvature * SIM_WHEELBASE / 2);
+        double safeTime = length / safeSpeed + safeSpeed / constraints.maxAcceleration;
+        double fullTime = length / constraints.maxVelocity + constraints.maxVelocity / constraints.maxAcceleration;
+        double overspeed = maxCurvature * SIM_WHEELBASE / 2 * 100;
+
+        printf("%-9s %6.0fin %9.2f %8.2fs %11.2fs %11.2fs %10.0f%%\n", route.name, length,
+            elapsed.count() / BENCH_REPEATS, trajectory.getDuration(), safeTime, fullTime, overspeed);
+    }
+    return 0;
+}
@@ -0,0 +1,219 @@
+/**
+ * \file trigCount.cpp
+ *
+ * \brief Counts the trig calls made by each control loop tick before and after poses cached their sine and cosine.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include tools/trigCount.cpp -o trigCount
+ *     ./trigCount
+ *
+ * Trig<TRIG_FAST> is replaced by a copy that counts its calls, and src/tracking/trackingData.cpp
+ * is compiled into this file so the real TrackingData and Pose2 code uses it. The "before" ticks
+ * are copies of the same code as it was before Rotation2 and Pose2, when toLocalCoordinates(),
+ * getForward() and moveToPoint() rotated with libm cos and sin on every call, and their libm
+ * calls are counted too. Each tick is run once to count its calls, then timed. The "before" times
+ * include libm being slower than fastTrig.h, which came after.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include "fastTrig.h"
+
+/**
+ * Number of timed runs of each tick
+*/
+#define BENCH_TICKS 2000000
+
+/**
+ * Sink for results so the compiler can't remove the work being timed
+*/
+static volatile double sink;
+
+/**
+ * Number of calls to each trig function since the last reset, sincos counting once
+*/
+static long sinCalls, cosCalls, atan2Calls, sincosCalls;
+
+/**
+ * Trig<TRIG_FAST> counting its calls. Declared before anything that uses it so the tracking code
+ * included below picks it up
+*/
+template <>
+struct Trig<TRIG_FAST> {
+    static double sin(double x) { sinCalls++; return fastSin(x); };
+    static double cos(double x) { cosCalls++; return fastCos(x); };
+    static double atan2(double y, double x) { atan2Calls++; return fastAtan2(y, x); };
+    static void sincos(double x, double& s, double& c) { sincosCalls++; fastSinCos(x, s, c); };
+};
+
+#include "../src/tracking/trackingData.cpp"
+
+/**
+ * TrackingData::update() reads pros::micros()
+*/
+extern "C" uint64_t micros(void) {
+    return 0;
+}
+
+/**
+ * libm calls made directly by the controllers and by the old code, counted
+*/
+static double countedSin(double x) { sinCalls++; return sin(x); }
+static double countedCos(double x) { cosCalls++; return cos(x); }
+static double countedAtan2(double y, double x) { atan2Calls++; return atan2(y, x); }
+
+/**
+ * Published pose, as the tracking task leaves it
+*/
+static TrackingData trackingData(24, -36, 0.7);
+
+/**
+ * Published pose as it was before it stored the sine and cosine of the heading
+*/
+static SeqLock<PoseSnapshot> oldPose;
+
+/**
+ * rotateVector() as it was, Vector2::rotate(angle) with libm
+*/
+static Vector2 oldRotateVector(Vector2 vec, double angle) {
+    return vec.rotate(countedCos(angle), countedSin(angle));
+}
+
+/**
+ * toLocalCoordinates() as it was
+*/
+static Vector2 oldToLocalCoordinates(Vector2 vec) {
+    return oldRotateVector(vec, -oldPose.read().heading);
+}
+
+/**
+ * DrivetrainPID::move() up to the drive output, the same then and now apart from the conversion
+*/
+static double moveOutput(Vector2 dir, double turn) {
+    double scalar = 1;
+    if ((fabs(dir.getX()) + fabs(dir.getY()) + fabs(turn)) > 1) {
+        scalar = fabs(dir.getX()) + fabs(dir.getY()) + fabs(turn);
+    }
+    return (dir.getMagnitude() - turn) / scalar * 127;
+}
+
+/**
+ * Point the ticks drive towards
+*/
+static const Vector2 target(48, 48);
+
+/**
+ * Stand in for the drive controller's output
+*/
+static double driveOutput(double distance) {
+    return -4 * distance;
+}
+
+// One tick of each loop, before
+
+static double oldTrackingTick(int i) {
+    PoseSnapshot snapshot;
+    snapshot.x = 24 + i * 1e-6;
+    snapshot.y = -36;
+    snapshot.heading = 0.7 + i * 1e-7;
+    oldPose.write(snapshot);
+    return 0;
+}
+
+static double oldMoveTick(int) {
+    return moveOutput(oldToLocalCoordinates(Vector2(30, 40)), 0);
+}
+
+static double oldForwardTick(int) {
+    return oldRotateVector(Vector2(0, 1), oldPose.read().heading).getX();
+}
+
+static double oldMoveToPointTick(int) {
+    // moveToPoint(): rotate (vel, 0) back along the delta, then move() converts it to local coordinates
+    PoseSnapshot pose = oldPose.read();
+    Vector2 delta = target - Vector2(pose.x, pose.y);
+    double vel = -driveOutput(delta.getMagnitude());
+    Vector2 driveVec = oldRotateVector(Vector2(vel, 0), countedAtan2(delta.getY(), delta.getX()));
+    return moveOutput(oldToLocalCoordinates(driveVec), 0);
+}
+
+// One tick of each loop, now
+
+static double trackingTick(int i) {
+    trackingData.update(24 + i * 1e-6, -36, 0.7 + i * 1e-7);
+    return 0;
+}
+
+static double moveTick(int) {
+    // toLocalCoordinates(dir) goes through the published pose
+    return moveOutput(trackingData.getPose().getRotation().unrotate(Vector2(30, 40)), 0);
+}
+
+static double forwardTick(int) {
+    return trackingData.getForward().getX();
+}
+
+static double moveToPointTick(int) {
+    // runMoveToPoint(): steer on the heading error, cos() is libm there
+    PoseSnapshot pose = trackingData.getSnapshot();
+    Vector2 delta = target - Vector2(pose.x, pose.y);
+    double vel = -driveOutput(delta.getMagnitude());
+    double headingError = remainder(delta.getHeading() - pose.heading, 2 * M_PI);
+    double forward = fabs(vel) * countedCos(headingError);
+    if (forward < 0) {
+        headingError = remainder(headingError + M_PI, 2 * M_PI);
+    }
+    return forward + headingError;
+}
+
+/**
+ * Run a tick once and count its trig calls
+ * @return Number of trig calls, sincos counting once
+*/
+template <typename Tick>
+static long countCalls(Tick tick) {
+    sinCalls = cosCalls = atan2Calls = sincosCalls = 0;
+    sink = tick(0);
+    return sinCalls + cosCalls + atan2Calls + sincosCalls;
+}
+
+/**
+ * Time BENCH_TICKS runs of a tick
+ * @return Nanoseconds per tick
+*/
+template <typename Tick>
+static double timeTicks(Tick tick) {
+    double total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_TICKS; i++) {
+        total += tick(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    sink = total;
+    return elapsed.count() / BENCH_TICKS;
+}
+
+/**
+ * Print the calls and time of a tick before and after
+*/
+template <typename Old, typename New>
+static void compare(const char* name, Old oldTick, New newTick) {
+    long oldCalls = countCalls(oldTick), newCalls = countCalls(newTick);
+    printf("%-30s %8ld %8ld %10.2f %10.2f\n", name, oldCalls, newCalls, timeTicks(oldTick), timeTicks(newTick));
+}
+
+int main() {
+    oldTrackingTick(0);
+    trackingTick(0);
+
+    printf("%-30s %8s %8s %10s %10s\n", "tick", "trig", "trig", "ns", "ns");
+    printf("%-30s %8s %8s %10s %10s\n", "", "before", "now", "before", "now");
+    compare("tracking update", oldTrackingTick, trackingTick);
+    compare("move(), one conversion", oldMoveTick, moveTick);
+    compare("getForward()", oldForwardTick, forwardTick);
+    compare("moveToPoint() loop", oldMoveToPointTick, moveToPointTick);
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * \file vectorBench.cpp
+ *
+ * \brief Compares the cost of the header-only Vector2 with the out of line Vector2 it replaced.
+ *
+ * Build and run with:
+ *
+ *     g++ -O2 -std=gnu++17 -iquote include tools/vectorBench.cpp -o vectorBench
+ *     ./vectorBench
+ *
+ * OldVector2 is a copy of Vector2 as it was in src/tracking/vector2.cpp, with every member kept out
+ * of line like a function in another translation unit, and oldRotateVector() is rotateVector() as
+ * it was in src/tracking/util.cpp. Each operation and a drive-to-point style sequence of them is
+ * timed over random vectors with both, and the results are compared. Exits with 1 if they differ
+ * by more than the tolerance.
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "tracking/vector2.h"
+
+/**
+ * Largest allowed difference between the old and new results, relative to their size. Rotations
+ * use fastTrig.h now, which is accurate to a few parts in a billion
+*/
+#define RESULT_TOLERANCE 1e-8
+
+/**
+ * Number of vectors each operation is timed over
+*/
+#define BENCH_VECTORS 4096
+
+/**
+ * Number of passes over the vectors for each operation
+*/
+#define BENCH_REPEATS 2000
+
+/**
+ * Sink for results so the compiler can't remove the work being timed
+*/
+static volatile double sink;
+
+/**
+ * \brief Vector2 before it was made header-only
+*/
+class OldVector2 {
+    public:
+        OldVector2(double x, double y);
+        OldVector2();
+
+        double getX() { return this->x; };
+        double getY() { return this->y; };
+
+        double getMagnitude();
+        OldVector2 normalize();
+
+        friend OldVector2 operator+(const OldVector2 &v1, const OldVector2 &v2);
+        friend OldVector2 operator-(const OldVector2 &v1, const OldVector2 &v2);
+        friend OldVector2 operator*(const OldVector2 &v1, const double scalar);
+
+    private:
+        double x;
+        double y;
+};
+
+__attribute__((noinline)) OldVector2::OldVector2(double x, double y) {
+    this->x = x;
+    this->y = y;
+}
+
+__attribute__((noinline)) OldVector2::OldVector2() {
+    this->x = 0;
+    this->y = 0;
+}
+
+__attribute__((noinline)) double OldVector2::getMagnitude() {
+    // Use pythagorean theorem
+    return sqrt(pow(this->x, 2) + pow(this->y, 2));
+}
+
+__attribute__((noinline)) OldVector2 OldVector2::normalize() {
+    // Divide x and y by magnitude to retain direction
+    return OldVector2(this->x / this->getMagnitude(), this->y / this->getMagnitude());
+}
+
+__attribute__((noinline)) OldVector2 operator+(const OldVector2 &v1, const OldVector2 &v2) {
+    return OldVector2(v1.x + v2.x, v1.y + v2.y);
+}
+
+__attribute__((noinline)) OldVector2 operator-(const OldVector2 &v1, const OldVector2 &v2) {
+    return OldVector2(v1.x - v2.x, v1.y - v2.y);
+}
+
+__attribute__((noinline)) OldVector2 operator*(const OldVector2 &v1, const double scalar) {
+    return OldVector2(v1.x * scalar, v1.y * scalar);
+}
+
+/**
+ * rotateVector() before it used Vector2::rotate()
+*/
+__attribute__((noinline)) OldVector2 oldRotateVector(OldVector2 vec, double angle) {
+    double newX = (vec.getX() * cos(angle)) - (vec.getY() * sin(angle));
+    double newY = (vec.getY() * cos(angle)) + (vec.getX() * sin(angle));
+    return OldVector2(newX, newY);
+}
+
+/**
+ * Returns a random value in range [low, high]
+*/
+static double random(double low, double high) {
+    return low + (high - low) * rand() / RAND_MAX;
+}
+
+/**
+ * Drive-to-point style sequence: aim a step of a given speed from a position towards a target and
+ * turn it into the robot's frame
+*/
+template <typename Vector, typename Rotate>
+static Vector aim(Vector position, Vector target, double speed, double heading, Rotate rotate) {
+    Vector delta = target - position;
+    double distance = delta.getMagnitude();
+    Vector step = delta.normalize() * fmin(speed, distance);
+    return rotate(step, heading);
+}
+
+/**
+ * Time an operation on every vector BENCH_REPEATS times
+ * @return Nanoseconds per operation
+*/
+template <typename Operation>
+static double timeOperation(Operation operation) {
+    double total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        for (int i = 0; i < BENCH_VECTORS; i++) {
+            total += operation(i);
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    sink = total;
+    return elapsed.count() / ((double) BENCH_REPEATS * BENCH_VECTORS);
+}
+
+int main() {
+    srand(1);
+    std::vector<double> x(BENCH_VECTORS), y(BENCH_VECTORS), angle(BENCH_VECTORS);
+    for (int i = 0; i < BENCH_VECTORS; i++) {
+        x[i] = random(-144, 144);
+        y[i] = random(-144, 144);
+        angle[i] = random(-M_PI, M_PI);
+    }
+    auto oldRotate = [](OldVector2 v, double a) { return oldRotateVector(v, a); };
+    auto newRotate = [](Vector2 v, double a) { return v.rotate(a); };
+
+    // Both versions should give the same results
+    double largest = 0;
+    for (int i = 0; i + 1 < BENCH_VECTORS; i++) {
+        OldVector2 oldResult = aim(OldVector2(x[i], y[i]), OldVector2(x[i + 1], y[i + 1]), 12, angle[i], oldRotate);
+        Vector2 newResult = aim(Vector2(x[i], y[i]), Vector2(x[i + 1], y[i + 1]), 12, angle[i], newRotate);
+        double scale = fmax(1, fmax(fabs(oldResult.getX()), fabs(oldResult.getY())));
+        largest = fmax(largest, fmax(fabs(oldResult.getX() - newResult.getX()), fabs(oldResult.getY() - newResult.getY())) / scale);
+    }
+    bool passed = largest <= RESULT_TOLERANCE;
+    printf("%-4s largest relative difference between old and new results %.3g (tolerance %.0e)\n\n",
+        passed ? "ok" : "FAIL", largest, RESULT_TOLERANCE);
+
+    const int last = BENCH_VECTORS - 1;
+    printf("%-24s %10s %10s\n", "operation", "old (ns)", "new (ns)");
+    printf("%-24s %10.2f %10.2f\n", "getMagnitude",
+        timeOperation([&](int i) { return OldVector2(x[i], y[i]).getMagnitude(); }),
+        timeOperation([&](int i) { return Vector2(x[i], y[i]).getMagnitude(); }));
+    printf("%-24s %10.2f %10.2f\n", "normalize",
+        timeOperation([&](int i) { return OldVector2(x[i], y[i]).normalize().getX(); }),
+        timeOperation([&](int i) { return Vector2(x[i], y[i]).normalize().getX(); }));
+    printf("%-24s %10.2f %10.2f\n", "(a - b) * s + a",
+        timeOperation([&](int i) { OldVector2 a(x[i], y[i]), b(y[i], x[i]); return ((a - b) * 0.5 + a).getY(); }),
+        timeOperation([&](int i) { Vector2 a(x[i], y[i]), b(y[i], x[i]); return ((a - b) * 0.5 + a).getY(); }));
+    printf("%-24s %10.2f %10.2f\n", "rotateVector",
+        timeOperation([&](int i) { return oldRotateVector(OldVector2(x[i], y[i]), angle[i]).getX(); }),
+        timeOperation([&](int i) { return Vector2(x[i], y[i]).rotate(angle[i]).getX(); }));
+    printf("%-24s %10.2f %10.2f\n", "aim at a point",
+        timeOperation([&](int i) { return aim(OldVector2(x[i], y[i]), OldVector2(x[last - i], y[last - i]), 12, angle[i], oldRotate).getX(); }),
+        timeOperation([&](int i) { return aim(Vector2(x[i], y[i]), Vector2(x[last - i], y[last - i]), 12, angle[i], newRotate).getX(); }));
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+/**
+ * \file velocitySim.cpp
+ * 
+ * \brief Compares DrivetrainPID's power and velocity output modes on a drivetrain model as the battery drains.
+ * 
+ * Build and run with:
+ * 
+ *     g++ -O2 -std=gnu++17 -iquote include tools/velocitySim.cpp -o velocitySim
+ *     ./velocitySim [--gain k] [--tau s] [--delay s] [--distance in]
+ * 
+ * In power mode the PID output goes straight to the motors, so a lower battery voltage makes
+ * the robot slower. In velocity mode the output is a velocity setpoint held by an inner loop,
+ * modelled on the motors' built-in velocity control, which makes up for the lower voltage.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "control/policyPID.h"
+#include "plantModel.h"
+
+/**
+ * Length of each simulated motion in seconds
+*/
+#define SIM_TIME 4
+
+/**
+ * Time in seconds at which the position along the motion is compared between battery voltages
+*/
+#define SIM_CHECK_TIME 0.75
+
+/**
+ * Fraction of the top velocity that full output asks for, the same as VELOCITY_MODE_MAX_FRACTION
+ * in drivetrainPID.h (which can't be included off the robot)
+*/
+#define VELOCITY_MODE_MAX_FRACTION 0.7
+
+/**
+ * Battery voltage that the plant gain is measured at
+*/
+#define SIM_NOMINAL_VOLTAGE 12.8
+
+/**
+ * \brief How a simulated motion went
+*/
+struct MotionResult {
+    double checkPosition = 0; // Position at SIM_CHECK_TIME
+    double settleTime = -1; // Time to get within 0.5in for good in seconds, -1 if it never did
+    double overshoot = 0; // Largest distance past the target
+};
+
+/**
+ * \brief Inner velocity loop, standing in for the motors' built-in velocity control
+*/
+class VelocityLoop {
+    public:
+        VelocityLoop(double gain) : gain(gain) {};
+
+        /**
+         * Run a step of the loop
+         * @param target The velocity setpoint
+         * @param velocity The measured velocity
+         * @return The power to send to the motor
+        */
+        double step(double target, double velocity) {
+            double error = target - velocity;
+            this->integral += error * SIM_DT;
+
+            // Feedforward from the nominal gain, feedback makes up for the rest
+            double power = (target / this->gain) + (8 * error) + (80 * this->integral);
+            if (fabs(power) > 127) {
+                // Stop integrating while saturated
+                this->integral -= error * SIM_DT;
+                power = power > 0 ? 127 : -127;
+            }
+            return power;
+        };
+
+    private:
+        double gain;
+        double integral = 0;
+};
+
+/**
+ * Simulate a motion to a distance
+ * @param velocityMode True to use the inner velocity loop
+*/
+static MotionResult simulate(bool velocityMode, double voltage, double gain, double tau, double delay, double distance) {
+    Plant plant(gain, tau, delay);
+    plant.setSupply(voltage / SIM_NOMINAL_VOLTAGE);
+
+    // Velocity mode gets a higher proportional gain, since the inner loop already handles the motor's lag
+    PIDInfo constants;
+    constants.p = velocityMode ? 24 : 8;
+    constants.i = 0;
+    constants.d = 0.5;
+    PID<PIDPolicy::OutputLimit> controller(constants, PIDPolicy::OutputLimit());
+    controller.target = distance;
+    VelocityLoop inner(gain);
+
+    MotionResult result;
+    for (int i = 1; i <= SIM_TIME / SIM_DT; i++) {
+        double output = controller.step(plant.getPosition(), SIM_DT);
+
+        if (velocityMode) {
+            // Full output is a fraction of the top velocity at full battery, like DrivetrainPID in OUTPUT_VELOCITY mode
+            double target = output / 127 * (VELOCITY_MODE_MAX_FRACTION * 127 * gain);
+            plant.step(inner.step(target, plant.getVelocity()));
+        } else {
+            plant.step(output);
+        }
+
+        double t = i * SIM_DT;
+        double error = distance - plant.getPosition();
+        if (fabs(t - SIM_CHECK_TIME) < SIM_DT / 2) {
+            result.checkPosition = plant.getPosition();
+        }
+        result.overshoot = fmax(result.overshoot, -error);
+        if (fabs(error) > 0.5) {
+            result.settleTime = -1;
+        } else if (result.settleTime < 0) {
+            result.settleTime = t;
+        }
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    double gain = 0.27, tau = 0.15, delay = 0.03, distance = 24;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--gain") == 0 && hasValue) {
+            gain = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tau") == 0 && hasValue) {
+            tau = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--delay") == 0 && hasValue) {
+            delay = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--distance") == 0 && hasValue) {
+            distance = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--gain k] [--tau s] [--delay s] [--distance in]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const double voltages[] = {12.8, 12.0, 11.0, 10.0, 9.0};
+    const char* names[] = {"power", "velocity"};
+
+    for (int mode = 0; mode < 2; mode++) {
+        printf("%s mode, %.0fin motion\n", names[mode], distance);
+        double minPosition = INFINITY, maxPosition = -INFINITY;
+        double minSettle = INFINITY, maxSettle = -INFINITY;
+
+        for (double voltage : voltages) {
+            MotionResult result = simulate(mode == 1, voltage, gain, tau, delay, distance);
+            minPosition = fmin(minPosition, result.checkPosition);
+            maxPosition = fmax(maxPosition, result.checkPosition);
+            minSettle = fmin(minSettle, result.settleTime);
+            maxSettle = fmax(maxSettle, result.settleTime);
+
+            printf("  %4.1fV  at %.2fs %6.2fin  overshoot %5.2fin  ", voltage, SIM_CHECK_TIME, result.checkPosition, result.overshoot);
+            if (result.settleTime >= 0) {
+                printf("settles in %.2fs\n", result.settleTime);
+            } else {
+                printf("does not settle\n");
+            }
+        }
+
+        printf("  across battery voltages, position at %.2fs varies by %.2fin and settle time by %.2fs\n",
+               SIM_CHECK_TIME, maxPosition - minPosition, maxSettle - minSettle);
+    }
+
+    return 0;
+}